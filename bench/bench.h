@@ -0,0 +1,31 @@
+/**********************************************************************************************
+*
+*   Shooter benchmarks - Suites Declarations
+*
+**********************************************************************************************/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Benchmark Suites Declaration
+//----------------------------------------------------------------------------------
+void RunBulletsBenchmark(void);     // MoveBullets() kernels, scalar vs SIMD
+void RunGameplayBenchmark(void);    // Headless gameplay simulation with scripted input
+void RunCollisionBenchmark(void);   // Bullet grid build and query vs brute force
+void RunEcsBenchmark(void);         // Entity iteration with 2 to 4 components vs array of structs
+void RunPatternsBenchmark(void);    // Volley writing and emitter spawn throughput
+void RunSnapshotBenchmark(void);    // Gameplay state save, restore and rollback through a snapshot ring
+void RunParticlesBenchmark(void);   // MoveParticles() kernels, then a pool of 100k live particles
+void RunPacingBenchmark(void);      // Frame interval error of the frame pacer vs a plain sleep
+int RunReplayBenchmark(const char *fileName, const char *patternsFileName);  // Recorded input log, returns 1 if checksums differ
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BENCH_H
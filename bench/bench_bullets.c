@@ -0,0 +1,196 @@
+/**********************************************************************************************
+*
+*   Shooter benchmarks - Bullets kernels
+*
+*   Times MoveBullets() (SIMD path the game was built with) against MoveBulletsScalar()
+*   on the same data and reports ns per bullet update. MoveBulletsParallel() is timed too,
+*   spreading the SIMD kernel over the job system threads.
+*
+*   Then the gameplay simulation (integrated projectiles, bullets stored in ECS chunks) is
+*   filled with up to BENCH_POOL_BULLETS bullets by an emitter, to check spawning and
+*   updating stay linear as chunks are added, and that a small budget drops spawns instead
+*   of growing past it. Fill time includes moving the bullets spawned on earlier ticks.
+*
+**********************************************************************************************/
+
+#include "bench.h"
+#include "bullets.h"
+#include "gameplay.h"
+#include "jobs.h"
+#include "timing.h"
+
+#include <stdio.h>          // Required for: printf()
+#include <stdlib.h>         // Required for: malloc(), free(), rand()
+#include <string.h>         // Required for: strlen()
+#include <math.h>           // Required for: cosf(), sinf()
+
+#define BENCH_BULLET_UPDATES    20000000    // Bullet updates timed per measure
+#define BENCH_REPEATS           5           // Best of N measures is reported
+#define BENCH_POOL_BULLETS      1000000     // Bullets spawned in the pool stress test, 1000 volleys of 1000
+#define BENCH_POOL_UPDATES      20          // Pool updates timed per measure
+#define BENCH_TICK_TIME         (1.0f/120.0f)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef int (*MoveBulletsFunc)(float *positionX, float *positionY, const float *directionX, const float *directionY,
+                               const float *speed, unsigned char *alive, int count, float dt, Rectangle bounds);
+
+typedef struct BulletsData {
+    float *positionX;
+    float *positionY;
+    float *directionX;
+    float *directionY;
+    float *speed;
+    unsigned char *alive;
+    int count;
+} BulletsData;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static BulletsData LoadBulletsData(int count)
+{
+    BulletsData data = { 0 };
+
+    data.positionX = (float *)malloc(count*sizeof(float));
+    data.positionY = (float *)malloc(count*sizeof(float));
+    data.directionX = (float *)malloc(count*sizeof(float));
+    data.directionY = (float *)malloc(count*sizeof(float));
+    data.speed = (float *)malloc(count*sizeof(float));
+    data.alive = (unsigned char *)malloc(count);
+    data.count = count;
+
+    srand(1234);
+    for (int i = 0; i < count; i++)
+    {
+        float angle = (float)rand()/RAND_MAX*6.2831853f;
+
+        data.positionX[i] = (float)(rand()%800);
+        data.positionY[i] = (float)(rand()%450);
+        data.directionX[i] = cosf(angle);
+        data.directionY[i] = sinf(angle);
+        data.speed[i] = 300.0f;
+        data.alive[i] = 1;
+    }
+
+    return data;
+}
+
+static void UnloadBulletsData(BulletsData data)
+{
+    free(data.positionX);
+    free(data.positionY);
+    free(data.directionX);
+    free(data.directionY);
+    free(data.speed);
+    free(data.alive);
+}
+
+// Best ns per bullet over BENCH_REPEATS measures
+static double MeasureKernel(MoveBulletsFunc move, BulletsData data)
+{
+    // Bounds far away from the spawn area, so no bullet is despawned and every
+    // measure runs the same amount of work
+    Rectangle bounds = { -1.0e7f, -1.0e7f, 2.0e7f, 2.0e7f };
+    int iterations = BENCH_BULLET_UPDATES/data.count;
+    double best = 0.0;
+
+    if (iterations < 1) iterations = 1;
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        unsigned long long start = GetTimestampNs();
+
+        for (int i = 0; i < iterations; i++)
+        {
+            move(data.positionX, data.positionY, data.directionX, data.directionY,
+                 data.speed, data.alive, data.count, 1.0f/120.0f, bounds);
+        }
+
+        double ns = (double)(GetTimestampNs() - start)/((double)iterations*data.count);
+        if ((r == 0) || (ns < best)) best = ns;
+    }
+
+    return best;
+}
+
+// Spawn bullets into gameplay entity storage with given budget, then time whole bullet updates
+// NOTE: Bullets crawl at 1 px/s from the field center, none leaves during the measure
+static void MeasurePool(int bullets, size_t budget)
+{
+    const char *fill = "pattern fill\n  arms 1000\n  speed 1\n  burst 1000\n  pause 1000000\n";
+    BulletPatterns patterns = LoadBulletPatternsFromMemory(fill, (int)strlen(fill));
+    Rectangle field = { 0, 0, 800, 450 };
+    GameInput input = { 0 };
+    int volleys = bullets/patterns.patterns[0].count;
+
+    SetGameplayBulletBudget(budget);
+    SetGameplayProjectileMode(PROJECTILE_INTEGRATED);
+    SetGameplayPatterns(&patterns);
+    InitGameplay(field);
+    AddGameplayEmitter(0, (Vector2){ field.width/2, field.height/2 });
+
+    // One volley per tick, then the emitter pauses for good
+    unsigned long long start = GetTimestampNs();
+
+    for (int t = 0; t <= volleys; t++) UpdateGameplay(input, BENCH_TICK_TIME);
+
+    double fillNs = (double)(GetTimestampNs() - start)/bullets;
+    double updateNs = 0.0;
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        start = GetTimestampNs();
+        for (int i = 0; i < BENCH_POOL_UPDATES; i++) UpdateGameplay(input, BENCH_TICK_TIME);
+
+        double ns = (double)(GetTimestampNs() - start)/((double)BENCH_POOL_UPDATES*GetGameplayBulletCount());
+        if ((r == 0) || (ns < updateNs)) updateNs = ns;
+    }
+
+    printf("%10d %10.1fMB %10d %10d %14.3f %14.3f\n", bullets, budget/(1024.0*1024.0), GetGameplayBulletCount(),
+           GetGameplayDroppedSpawns(), fillNs, updateNs);
+    printf("%10s %10.1fMB held by the simulation, %d bullet chunks\n", "", GetGameplayMemory()/(1024.0*1024.0), GetGameplayBulletChunkCount());
+
+    UnloadGameplay();
+    SetGameplayPatterns(NULL);
+    SetGameplayBulletBudget(BULLETS_DEFAULT_BUDGET);
+    SetGameplayProjectileMode(PROJECTILE_ANALYTIC);
+    UnloadBulletPatterns(patterns);
+}
+
+//----------------------------------------------------------------------------------
+// Benchmark Suite Definition
+//----------------------------------------------------------------------------------
+void RunBulletsBenchmark(void)
+{
+    const int counts[] = { 1000, 10000, 100000 };
+    char simdHeader[32] = { 0 };
+    char jobsHeader[32] = { 0 };
+
+    InitJobSystem(0);
+
+    snprintf(simdHeader, sizeof(simdHeader), "%s ns/b", GetBulletKernelName());
+    snprintf(jobsHeader, sizeof(jobsHeader), "%d threads ns/b", GetJobThreadCount());
+    printf("%10s %14s %14s %10s %18s %10s\n", "bullets", "scalar ns/b", simdHeader, "speedup", jobsHeader, "speedup");
+
+    for (int c = 0; c < (int)(sizeof(counts)/sizeof(counts[0])); c++)
+    {
+        BulletsData data = LoadBulletsData(counts[c]);
+
+        double scalar = MeasureKernel(MoveBulletsScalar, data);
+        double simd = MeasureKernel(MoveBullets, data);
+        double jobs = MeasureKernel(MoveBulletsParallel, data);
+
+        printf("%10d %14.3f %14.3f %9.2fx %18.3f %9.2fx\n", counts[c], scalar, simd, scalar/simd, jobs, scalar/jobs);
+
+        UnloadBulletsData(data);
+    }
+
+    printf("\n%10s %12s %10s %10s %14s %14s\n", "bullets", "budget", "alive", "dropped", "fill ns/b", "update ns/b");
+
+    MeasurePool(BENCH_POOL_BULLETS, BULLETS_DEFAULT_BUDGET);
+    MeasurePool(BENCH_POOL_BULLETS, 4*1024*1024);
+
+    CloseJobSystem();
+}
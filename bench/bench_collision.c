@@ -0,0 +1,230 @@
+/**********************************************************************************************
+*
+*   Shooter benchmarks - Collision broad-phase
+*
+*   Times BuildBulletGrid() and a full bullets vs targets query on the grid, against the
+*   brute force test of every pair, for several bullet and target counts. Then the same for
+*   swept queries, bullets moving at 600 px/s for ticks of 1/60 s to 1/4 s against thin
+*   walls, with the hits a static test of end positions finds.
+*
+**********************************************************************************************/
+
+#include "bench.h"
+#include "collision.h"
+#include "timing.h"
+
+#include <stdio.h>          // Required for: printf()
+#include <stdlib.h>         // Required for: malloc(), free(), rand()
+#include <math.h>           // Required for: cosf(), sinf()
+
+#define BENCH_REPEATS       20          // Measures averaged per case
+#define BENCH_BULLET_RADIUS 4.0f
+#define BENCH_CELL_SIZE     32.0f
+#define BENCH_MAX_HITS      65536
+#define BENCH_BULLET_SPEED  600.0f
+#define BENCH_WALL_WIDTH    2.0f
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void RunSweptBenchmark(CollisionHit *hits);
+
+//----------------------------------------------------------------------------------
+// Benchmark Suite Definition
+//----------------------------------------------------------------------------------
+void RunCollisionBenchmark(void)
+{
+    const int bulletCounts[] = { 1000, 10000, 50000 };
+    const int targetCounts[] = { 100, 1000 };
+    Rectangle field = { 0, 0, 800, 450 };
+
+    CollisionHit *hits = (CollisionHit *)malloc(BENCH_MAX_HITS*sizeof(CollisionHit));
+
+    printf("%8s %8s %12s %12s %14s %8s\n", "bullets", "targets", "build us", "query us", "brute us", "hits");
+
+    for (int b = 0; b < (int)(sizeof(bulletCounts)/sizeof(bulletCounts[0])); b++)
+    {
+        int bulletCount = bulletCounts[b];
+        float *positionX = (float *)malloc(bulletCount*sizeof(float));
+        float *positionY = (float *)malloc(bulletCount*sizeof(float));
+
+        srand(4321);
+        for (int i = 0; i < bulletCount; i++)
+        {
+            positionX[i] = (float)rand()/RAND_MAX*field.width;
+            positionY[i] = (float)rand()/RAND_MAX*field.height;
+        }
+
+        BulletGrid grid = { 0 };
+        InitBulletGrid(&grid, field, BENCH_CELL_SIZE, bulletCount);
+
+        for (int t = 0; t < (int)(sizeof(targetCounts)/sizeof(targetCounts[0])); t++)
+        {
+            int targetCount = targetCounts[t];
+            Vector2 *centers = (Vector2 *)malloc(targetCount*sizeof(Vector2));
+            float *radii = (float *)malloc(targetCount*sizeof(float));
+
+            for (int i = 0; i < targetCount; i++)
+            {
+                centers[i].x = (float)rand()/RAND_MAX*field.width;
+                centers[i].y = (float)rand()/RAND_MAX*field.height;
+                radii[i] = 8.0f + (float)(rand()%16);
+            }
+
+            unsigned long long buildNs = 0;
+            unsigned long long queryNs = 0;
+            unsigned long long bruteNs = 0;
+            int gridHits = 0;
+            int bruteHits = 0;
+
+            for (int r = 0; r < BENCH_REPEATS; r++)
+            {
+                unsigned long long start = GetTimestampNs();
+                BuildBulletGrid(&grid, positionX, positionY, bulletCount);
+                unsigned long long built = GetTimestampNs();
+                gridHits = CollideBulletsTargets(&grid, positionX, positionY, BENCH_BULLET_RADIUS,
+                                                 centers, radii, targetCount, hits, BENCH_MAX_HITS);
+                unsigned long long queried = GetTimestampNs();
+
+                buildNs += built - start;
+                queryNs += queried - built;
+            }
+
+            // Brute force is slow at high counts, fewer repeats are enough
+            for (int r = 0; r < BENCH_REPEATS/4; r++)
+            {
+                unsigned long long start = GetTimestampNs();
+                bruteHits = CollideBulletsTargetsBruteForce(positionX, positionY, bulletCount, BENCH_BULLET_RADIUS,
+                                                            centers, radii, targetCount, hits, BENCH_MAX_HITS);
+                bruteNs += GetTimestampNs() - start;
+            }
+
+            printf("%8d %8d %12.1f %12.1f %14.1f %8d%s\n", bulletCount, targetCount,
+                   buildNs/1000.0/BENCH_REPEATS, queryNs/1000.0/BENCH_REPEATS, bruteNs/1000.0/(BENCH_REPEATS/4),
+                   gridHits, (gridHits == bruteHits)? "" : "  MISMATCH");
+
+            free(centers);
+            free(radii);
+        }
+
+        UnloadBulletGrid(&grid);
+        free(positionX);
+        free(positionY);
+    }
+
+    RunSweptBenchmark(hits);
+
+    free(hits);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static void RunSweptBenchmark(CollisionHit *hits)
+{
+    const float tickTimes[] = { 1.0f/60.0f, 1.0f/15.0f, 1.0f/4.0f };
+    const int bulletCount = 10000;
+    const int wallCount = 100;
+    Rectangle field = { 0, 0, 800, 450 };
+
+    float *positionX = (float *)malloc(bulletCount*sizeof(float));
+    float *positionY = (float *)malloc(bulletCount*sizeof(float));
+    float *directionX = (float *)malloc(bulletCount*sizeof(float));
+    float *directionY = (float *)malloc(bulletCount*sizeof(float));
+    float *motionX = (float *)malloc(bulletCount*sizeof(float));
+    float *motionY = (float *)malloc(bulletCount*sizeof(float));
+    float *endX = (float *)malloc(bulletCount*sizeof(float));
+    float *endY = (float *)malloc(bulletCount*sizeof(float));
+    Vector2 centers[100] = { 0 };
+    Vector2 halfSizes[100] = { 0 };
+    float radii[100] = { 0 };
+
+    srand(4321);
+    for (int i = 0; i < bulletCount; i++)
+    {
+        float angle = (float)rand()/RAND_MAX*2.0f*PI;
+        positionX[i] = (float)rand()/RAND_MAX*field.width;
+        positionY[i] = (float)rand()/RAND_MAX*field.height;
+        directionX[i] = cosf(angle);
+        directionY[i] = sinf(angle);
+    }
+
+    // Thin walls, half vertical and half horizontal
+    for (int i = 0; i < wallCount; i++)
+    {
+        float length = 20.0f + (float)(rand()%40);
+        centers[i].x = (float)rand()/RAND_MAX*field.width;
+        centers[i].y = (float)rand()/RAND_MAX*field.height;
+        halfSizes[i] = (i%2 == 0)? (Vector2){ BENCH_WALL_WIDTH/2, length/2 } : (Vector2){ length/2, BENCH_WALL_WIDTH/2 };
+    }
+
+    BulletGrid grid = { 0 };
+    InitBulletGrid(&grid, field, BENCH_CELL_SIZE, bulletCount);
+
+    printf("\n%d bullets at %.0f px/s, %d walls %.0f px wide, bullet radius %.0f\n", bulletCount, BENCH_BULLET_SPEED, wallCount, BENCH_WALL_WIDTH, BENCH_BULLET_RADIUS);
+    printf("%8s %8s %12s %12s %14s %8s %12s\n", "tick ms", "motion", "build us", "query us", "brute us", "hits", "static hits");
+
+    for (int t = 0; t < (int)(sizeof(tickTimes)/sizeof(tickTimes[0])); t++)
+    {
+        float step = BENCH_BULLET_SPEED*tickTimes[t];
+
+        for (int i = 0; i < bulletCount; i++)
+        {
+            motionX[i] = directionX[i]*step;
+            motionY[i] = directionY[i]*step;
+            endX[i] = positionX[i] + motionX[i];
+            endY[i] = positionY[i] + motionY[i];
+        }
+
+        unsigned long long buildNs = 0;
+        unsigned long long queryNs = 0;
+        unsigned long long bruteNs = 0;
+        int sweptHits = 0;
+        int bruteHits = 0;
+
+        for (int r = 0; r < BENCH_REPEATS; r++)
+        {
+            unsigned long long start = GetTimestampNs();
+            BuildSweptBulletGrid(&grid, positionX, positionY, motionX, motionY, bulletCount);
+            unsigned long long built = GetTimestampNs();
+            sweptHits = CollideSweptBulletsTargets(&grid, positionX, positionY, motionX, motionY, BENCH_BULLET_RADIUS,
+                                                   centers, halfSizes, radii, wallCount, hits, BENCH_MAX_HITS);
+            unsigned long long queried = GetTimestampNs();
+
+            buildNs += built - start;
+            queryNs += queried - built;
+        }
+
+        for (int r = 0; r < BENCH_REPEATS/4; r++)
+        {
+            unsigned long long start = GetTimestampNs();
+            bruteHits = CollideSweptBulletsTargetsBruteForce(positionX, positionY, motionX, motionY, bulletCount, BENCH_BULLET_RADIUS,
+                                                             centers, halfSizes, radii, wallCount, hits, BENCH_MAX_HITS);
+            bruteNs += GetTimestampNs() - start;
+        }
+
+        // What testing end positions only would find
+        int staticHits = 0;
+        for (int i = 0; i < bulletCount; i++)
+        {
+            for (int w = 0; w < wallCount; w++)
+            {
+                if (GetSweptContactTime((Vector2){ endX[i], endY[i] }, (Vector2){ 0.0f, 0.0f }, BENCH_BULLET_RADIUS, centers[w], halfSizes[w], 0.0f) == 0.0f) staticHits++;
+            }
+        }
+
+        printf("%8.1f %8.1f %12.1f %12.1f %14.1f %8d %12d%s\n", tickTimes[t]*1000.0f, step,
+               buildNs/1000.0/BENCH_REPEATS, queryNs/1000.0/BENCH_REPEATS, bruteNs/1000.0/(BENCH_REPEATS/4),
+               sweptHits, staticHits, (sweptHits == bruteHits)? "" : "  MISMATCH");
+    }
+
+    UnloadBulletGrid(&grid);
+    free(positionX);
+    free(positionY);
+    free(directionX);
+    free(directionY);
+    free(motionX);
+    free(motionY);
+    free(endX);
+    free(endY);
+}
@@ -0,0 +1,226 @@
+/**********************************************************************************************
+*
+*   Shooter benchmarks - Entity-component system iteration
+*
+*   Times a movement system over 100k entities having 2, 3 and 4 components, through
+*   EcsWorld::ForEach() (one call per entity) and EcsWorld::ForEachChunk() (component arrays),
+*   against a plain array of structs holding every field. Last case spreads the same
+*   entities over 4 archetypes the query matches, chunks are then partly filled.
+*
+**********************************************************************************************/
+
+#include "bench.h"
+#include "ecs.hpp"
+#include "timing.h"
+
+#include <stdio.h>          // Required for: printf()
+#include <stdlib.h>         // Required for: malloc(), free(), rand()
+
+#define BENCH_ENTITIES      100000
+#define BENCH_REPEATS       50          // Measures averaged per case
+#define BENCH_DT            (1.0f/60.0f)
+#define BENCH_BUDGET        (64*1024*1024)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+struct Position { float x, y; };
+struct Velocity { float x, y; };
+struct Health { float value; };
+struct Team { int value; };
+
+// Every field an entity may have, what an array of game objects would hold
+struct GameObject {
+    Position position;
+    Velocity velocity;
+    Health health;
+    Team team;
+};
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void CreateEntities(EcsWorld &world, int componentCount, int count);
+static double TimeForEach(EcsWorld &world, int componentCount);
+static double TimeForEachChunk(EcsWorld &world, int componentCount);
+static double TimeObjects(GameObject *objects, int count, int componentCount);
+static int CountChunks(EcsWorld &world);
+
+//----------------------------------------------------------------------------------
+// Benchmark Suite Definition
+//----------------------------------------------------------------------------------
+void RunEcsBenchmark(void)
+{
+    GameObject *objects = (GameObject *)malloc(BENCH_ENTITIES*sizeof(GameObject));
+
+    srand(1234);
+    for (int i = 0; i < BENCH_ENTITIES; i++)
+    {
+        objects[i].position = Position{ (float)(rand()%800), (float)(rand()%450) };
+        objects[i].velocity = Velocity{ (float)(rand()%200 - 100), (float)(rand()%200 - 100) };
+        objects[i].health = Health{ 100.0f };
+        objects[i].team = Team{ rand()%2 };
+    }
+
+    printf("%-12s %8s %8s %14s %14s %14s %12s\n", "components", "entities", "chunks", "foreach ns/e", "chunk ns/e", "aos ns/e", "ecs MB");
+
+    for (int components = 2; components <= 4; components++)
+    {
+        EcsWorld world;
+        world.Init(BENCH_BUDGET);
+        CreateEntities(world, components, BENCH_ENTITIES);
+
+        printf("%-12d %8d %8d %14.2f %14.2f %14.2f %12.2f\n", components, world.Count<Position>(), CountChunks(world),
+               TimeForEach(world, components), TimeForEachChunk(world, components),
+               TimeObjects(objects, BENCH_ENTITIES, components), world.GetMemory()/(1024.0*1024.0));
+
+        world.Unload();
+    }
+
+    // Same entities over several archetypes, a 2 components query visits all of them
+    EcsWorld world;
+    world.Init(BENCH_BUDGET);
+    CreateEntities(world, 2, BENCH_ENTITIES/4);
+    CreateEntities(world, 3, BENCH_ENTITIES/4);
+    CreateEntities(world, 4, BENCH_ENTITIES/4);
+    for (int i = 0; i < BENCH_ENTITIES/4; i++) world.Create(Position{ 0.0f, 0.0f }, Velocity{ 1.0f, 1.0f }, Team{ 0 });
+
+    printf("%-12s %8d %8d %14.2f %14.2f %14.2f %12.2f\n", "2 (4 arch)", world.Count<Position>(), CountChunks(world),
+           TimeForEach(world, 2), TimeForEachChunk(world, 2),
+           TimeObjects(objects, BENCH_ENTITIES, 2), world.GetMemory()/(1024.0*1024.0));
+
+    world.Unload();
+    free(objects);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static void CreateEntities(EcsWorld &world, int componentCount, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        Position position = { (float)(rand()%800), (float)(rand()%450) };
+        Velocity velocity = { (float)(rand()%200 - 100), (float)(rand()%200 - 100) };
+
+        if (componentCount == 2) world.Create(position, velocity);
+        else if (componentCount == 3) world.Create(position, velocity, Health{ 100.0f });
+        else world.Create(position, velocity, Health{ 100.0f }, Team{ rand()%2 });
+    }
+}
+
+// Movement system, depending on components health decays and team 1 moves twice as fast
+static double TimeForEach(EcsWorld &world, int componentCount)
+{
+    unsigned long long start = GetTimestampNs();
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        if (componentCount == 2)
+        {
+            world.ForEach<Position, Velocity>([](Position &position, Velocity &velocity)
+            {
+                position.x += velocity.x*BENCH_DT;
+                position.y += velocity.y*BENCH_DT;
+            });
+        }
+        else if (componentCount == 3)
+        {
+            world.ForEach<Position, Velocity, Health>([](Position &position, Velocity &velocity, Health &health)
+            {
+                position.x += velocity.x*BENCH_DT;
+                position.y += velocity.y*BENCH_DT;
+                health.value -= BENCH_DT;
+            });
+        }
+        else
+        {
+            world.ForEach<Position, Velocity, Health, Team>([](Position &position, Velocity &velocity, Health &health, Team &team)
+            {
+                float scale = BENCH_DT*(float)(1 + team.value);
+                position.x += velocity.x*scale;
+                position.y += velocity.y*scale;
+                health.value -= BENCH_DT;
+            });
+        }
+    }
+
+    return (double)(GetTimestampNs() - start)/BENCH_REPEATS/world.Count<Position>();
+}
+
+static double TimeForEachChunk(EcsWorld &world, int componentCount)
+{
+    unsigned long long start = GetTimestampNs();
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        if (componentCount == 2)
+        {
+            world.ForEachChunk<Position, Velocity>([](int count, Position *position, Velocity *velocity)
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    position[i].x += velocity[i].x*BENCH_DT;
+                    position[i].y += velocity[i].y*BENCH_DT;
+                }
+            });
+        }
+        else if (componentCount == 3)
+        {
+            world.ForEachChunk<Position, Velocity, Health>([](int count, Position *position, Velocity *velocity, Health *health)
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    position[i].x += velocity[i].x*BENCH_DT;
+                    position[i].y += velocity[i].y*BENCH_DT;
+                    health[i].value -= BENCH_DT;
+                }
+            });
+        }
+        else
+        {
+            world.ForEachChunk<Position, Velocity, Health, Team>([](int count, Position *position, Velocity *velocity, Health *health, Team *team)
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    float scale = BENCH_DT*(float)(1 + team[i].value);
+                    position[i].x += velocity[i].x*scale;
+                    position[i].y += velocity[i].y*scale;
+                    health[i].value -= BENCH_DT;
+                }
+            });
+        }
+    }
+
+    return (double)(GetTimestampNs() - start)/BENCH_REPEATS/world.Count<Position>();
+}
+
+// Same work on an array of structs, unused fields are loaded with the used ones
+static double TimeObjects(GameObject *objects, int count, int componentCount)
+{
+    unsigned long long start = GetTimestampNs();
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            GameObject *object = &objects[i];
+            float scale = (componentCount == 4)? BENCH_DT*(float)(1 + object->team.value) : BENCH_DT;
+
+            object->position.x += object->velocity.x*scale;
+            object->position.y += object->velocity.y*scale;
+            if (componentCount >= 3) object->health.value -= BENCH_DT;
+        }
+    }
+
+    return (double)(GetTimestampNs() - start)/BENCH_REPEATS/count;
+}
+
+static int CountChunks(EcsWorld &world)
+{
+    int chunks = 0;
+
+    world.ForEachChunk<Position>([&chunks](int, Position *) { chunks++; });
+
+    return chunks;
+}
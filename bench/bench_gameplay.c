@@ -0,0 +1,238 @@
+/**********************************************************************************************
+*
+*   Shooter benchmarks - Headless gameplay simulation
+*
+*   Drives the gameplay simulation with scripted input, no window is opened. Reports
+*   throughput (ticks/s, bullet updates/s) and tick latency percentiles per scenario, with
+*   analytic and integrated projectiles.
+*
+*   Also checks that a bullet crossing a thin wall and leaving the field on the same tick
+*   still hits the wall, with both projectile modes.
+*
+**********************************************************************************************/
+
+#include "bench.h"
+#include "gameplay.h"
+#include "timing.h"
+
+#include <stdio.h>          // Required for: printf()
+#include <stdlib.h>         // Required for: malloc(), free(), qsort()
+#include <math.h>           // Required for: sinf()
+#include <string.h>         // Required for: strlen()
+
+#define BENCH_TICKS         60000           // Ticks simulated per scenario
+#define BENCH_TICK_TIME     (1.0f/60.0f)
+#define EDGE_TICK_TIME      0.5f            // Player bullets move 150 px per tick
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct GameplayScenario {
+    const char *name;
+    void (*setup)(void);                    // Called after InitGameplay(), can be NULL
+    GameInput (*script)(int tick);          // Synthetic input for a tick
+} GameplayScenario;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static GameInput ScriptIdle(int tick);
+static GameInput ScriptStrafe(int tick);
+static GameInput ScriptBarrage(int tick);
+static void SetupTargets(void);
+static void SetupWalls(void);
+static void SetupVolleys(void);
+static bool CheckEdgeHits(ProjectileMode mode);
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static const Rectangle benchField = { 0, 0, 800, 450 };
+
+// Slow rings, bullets stay on the field for about 10 seconds
+static const char *benchPatterns = "pattern ring\n  arms 64\n  speed 40\n  spin 3\n  interval 4\n";
+static BulletPatterns patterns = { 0 };
+
+static const ProjectileMode modes[] = { PROJECTILE_ANALYTIC, PROJECTILE_INTEGRATED };
+static const char *modeNames[] = { "analytic", "integrated" };
+
+static const GameplayScenario scenarios[] = {
+    { "idle", NULL, ScriptIdle },               // Player standing still, nothing fired
+    { "strafe", NULL, ScriptStrafe },           // Moving side to side, firing every 4 ticks
+    { "barrage", NULL, ScriptBarrage },         // Firing every tick, aim sweeping the field
+    { "targets", SetupTargets, ScriptBarrage }, // Barrage against a field full of targets
+    { "walls", SetupWalls, ScriptBarrage },     // Barrage against walls thinner than a bullet
+    { "volleys", SetupVolleys, ScriptIdle },    // Tens of thousands of bullets nothing collides with
+};
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static GameInput ScriptIdle(int tick)
+{
+    (void)tick;
+
+    GameInput input = { 0 };
+    input.cursor.x = benchField.width/2;
+    input.cursor.y = 0;
+
+    return input;
+}
+
+static GameInput ScriptStrafe(int tick)
+{
+    GameInput input = { 0 };
+    input.cursor.x = benchField.width/2 + sinf(tick*0.01f)*benchField.width/2;
+    input.cursor.y = benchField.height/4;
+    input.moveLeft = ((tick/120)%2) == 0;
+    input.moveRight = !input.moveLeft;
+    input.fire = (tick%4) == 0;
+
+    return input;
+}
+
+static GameInput ScriptBarrage(int tick)
+{
+    GameInput input = { 0 };
+    input.cursor.x = benchField.width/2 + sinf(tick*0.05f)*benchField.width/2;
+    input.cursor.y = benchField.height/8;
+    input.fire = true;
+
+    return input;
+}
+
+static void SetupTargets(void)
+{
+    for (int row = 0; row < 4; row++)
+    {
+        for (int column = 0; column < 16; column++)
+        {
+            Vector2 center = { 25.0f + column*50.0f, 40.0f + row*60.0f };
+            AddGameplayTarget(center, 12.0f);
+        }
+    }
+}
+
+static void SetupWalls(void)
+{
+    for (int row = 0; row < 4; row++)
+    {
+        for (int column = 0; column < 8; column++)
+        {
+            Rectangle wall = { 20.0f + column*100.0f, 40.0f + row*60.0f, 60.0f, 1.0f };
+            AddGameplayBoxTarget(wall);
+        }
+    }
+}
+
+static void SetupVolleys(void)
+{
+    SetGameplayPatterns(&patterns);
+
+    for (int i = 0; i < 8; i++)
+    {
+        Vector2 position = { benchField.width*(i + 0.5f)/8, benchField.height/2 };
+        AddGameplayEmitter(0, position);
+    }
+}
+
+// One bullet fired right at a 2 px wall 8 px from the field edge, it crosses the wall and
+// leaves the field on its third tick
+static bool CheckEdgeHits(ProjectileMode mode)
+{
+    GameInput input = { 0 };
+    Rectangle wall = { benchField.width - 10.0f, 0.0f, 2.0f, benchField.height };
+
+    SetGameplayProjectileMode(mode);
+    InitGameplay(benchField);
+    AddGameplayBoxTarget(wall);
+
+    input.cursor = GetPlayerPosition(1.0f);
+    input.cursor.x = benchField.width;
+    input.fire = true;
+
+    for (int t = 0; t < 4; t++)
+    {
+        UpdateGameplay(input, EDGE_TICK_TIME);
+        input.fire = false;
+    }
+
+    bool hit = (GetGameplayTarget(0).hits == 1) && (GetGameplayBulletCount() == 0);
+
+    UnloadGameplay();
+
+    return hit;
+}
+
+static int CompareTicks(const void *a, const void *b)
+{
+    unsigned long long ta = *(const unsigned long long *)a;
+    unsigned long long tb = *(const unsigned long long *)b;
+
+    return (ta > tb) - (ta < tb);
+}
+
+// Value at percentile p [0..100] of sorted samples
+static double GetPercentileUs(const unsigned long long *sorted, int count, double p)
+{
+    int index = (int)(p/100.0*(count - 1) + 0.5);
+    return sorted[index]/1000.0;
+}
+
+static void RunScenario(const GameplayScenario *scenario, int mode, unsigned long long *tickTimes)
+{
+    unsigned long long bulletUpdates = 0;
+
+    SetGameplayProjectileMode(modes[mode]);
+    InitGameplay(benchField);
+    if (scenario->setup != NULL) scenario->setup();
+
+    unsigned long long start = GetTimestampNs();
+
+    for (int t = 0; t < BENCH_TICKS; t++)
+    {
+        GameInput input = scenario->script(t);
+
+        unsigned long long tickStart = GetTimestampNs();
+        UpdateGameplay(input, BENCH_TICK_TIME);
+        tickTimes[t] = GetTimestampNs() - tickStart;
+
+        bulletUpdates += GetGameplayBulletCount();
+    }
+
+    double seconds = (GetTimestampNs() - start)/1e9;
+
+    qsort(tickTimes, BENCH_TICKS, sizeof(unsigned long long), CompareTicks);
+
+    printf("%-10s %-10s %12.0f %14.0f %10.1f %9.2f %9.2f %9.2f %9.2f\n", scenario->name, modeNames[mode],
+           BENCH_TICKS/seconds, bulletUpdates/seconds, (double)bulletUpdates/BENCH_TICKS,
+           GetPercentileUs(tickTimes, BENCH_TICKS, 50.0), GetPercentileUs(tickTimes, BENCH_TICKS, 90.0),
+           GetPercentileUs(tickTimes, BENCH_TICKS, 99.0), tickTimes[BENCH_TICKS - 1]/1000.0);
+
+    UnloadGameplay();
+}
+
+//----------------------------------------------------------------------------------
+// Benchmark Suite Definition
+//----------------------------------------------------------------------------------
+void RunGameplayBenchmark(void)
+{
+    unsigned long long *tickTimes = (unsigned long long *)malloc(BENCH_TICKS*sizeof(unsigned long long));
+
+    printf("%d ticks per scenario, tick latency in us\n", BENCH_TICKS);
+    printf("%-10s %-10s %12s %14s %10s %9s %9s %9s %9s\n", "scenario", "bullets", "ticks/s", "bullets/s", "avg live", "p50", "p90", "p99", "max");
+
+    patterns = LoadBulletPatternsFromMemory(benchPatterns, (int)strlen(benchPatterns));
+
+    for (int s = 0; s < (int)(sizeof(scenarios)/sizeof(scenarios[0])); s++)
+    {
+        for (int m = 0; m < (int)(sizeof(modes)/sizeof(modes[0])); m++) RunScenario(&scenarios[s], m, tickTimes);
+    }
+
+    printf("edge wall hits: analytic %s, integrated %s\n", CheckEdgeHits(PROJECTILE_ANALYTIC)? "hit" : "MISSED",
+           CheckEdgeHits(PROJECTILE_INTEGRATED)? "hit" : "MISSED");
+
+    SetGameplayProjectileMode(PROJECTILE_ANALYTIC);
+    UnloadBulletPatterns(patterns);
+    free(tickTimes);
+}
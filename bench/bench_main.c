@@ -0,0 +1,82 @@
+/**********************************************************************************************
+*
+*   Shooter benchmarks
+*
+*   Usage: shooter_bench [suite]
+*     bullets   MoveBullets() ns/bullet, scalar vs SIMD
+*     gameplay  Headless simulation throughput and tick latency, scripted scenarios
+*     collision Bullet grid build and query time vs brute force
+*     ecs       Entity iteration with 2 to 4 components, ForEach vs chunk arrays vs array of structs
+*     patterns  Volley writing ns/bullet, emitter spawns per tick and per second
+*     snapshot  State save, push and restore times, snapshot ring memory, rollback check
+*     particles MoveParticles() ns/particle, scalar vs SIMD, tick time of 100k live particles
+*     pacing    Frame interval jitter histogram at 60/120/144 fps, frame pacer vs plain sleep
+*
+*   With no suite given, every suite is run.
+*
+*   Usage: shooter_bench replay <file> [patterns file]
+*     Replays an input log recorded in game, exit code is 1 if the simulation diverged.
+*
+**********************************************************************************************/
+
+#include "bench.h"
+
+#include <stdbool.h>        // Required for: bool
+#include <stdio.h>          // Required for: printf()
+#include <string.h>         // Required for: strcmp()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct BenchSuite {
+    const char *name;
+    void (*run)(void);
+} BenchSuite;
+
+//----------------------------------------------------------------------------------
+// Local Variables Definition (local to this module)
+//----------------------------------------------------------------------------------
+static const BenchSuite suites[] = {
+    { "bullets", RunBulletsBenchmark },
+    { "gameplay", RunGameplayBenchmark },
+    { "collision", RunCollisionBenchmark },
+    { "ecs", RunEcsBenchmark },
+    { "patterns", RunPatternsBenchmark },
+    { "snapshot", RunSnapshotBenchmark },
+    { "particles", RunParticlesBenchmark },
+    { "pacing", RunPacingBenchmark },
+};
+
+static const int suitesCount = sizeof(suites)/sizeof(suites[0]);
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    const char *selected = (argc > 1)? argv[1] : NULL;
+    bool found = false;
+
+    // Replay is not part of the suites run by default, it needs a recorded log
+    if ((selected != NULL) && (strcmp(selected, "replay") == 0)) return RunReplayBenchmark((argc > 2)? argv[2] : NULL, (argc > 3)? argv[3] : NULL);
+
+    for (int i = 0; i < suitesCount; i++)
+    {
+        if ((selected != NULL) && (strcmp(selected, suites[i].name) != 0)) continue;
+
+        printf("== %s ==\n", suites[i].name);
+        suites[i].run();
+        printf("\n");
+        found = true;
+    }
+
+    if (!found)
+    {
+        printf("Unknown suite '%s', available:", selected);
+        for (int i = 0; i < suitesCount; i++) printf(" %s", suites[i].name);
+        printf("\n");
+        return 1;
+    }
+
+    return 0;
+}
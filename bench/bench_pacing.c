@@ -0,0 +1,128 @@
+/**********************************************************************************************
+*
+*   Shooter benchmarks - Frame pacing
+*
+*   Runs frames of varying work at 60, 120 and 144 frames per second, waiting for the next
+*   frame either with a plain millisecond sleep (coarse wait) or with the frame pacer
+*   (calibrated sleep, then spin). Reports frame interval error against the target period
+*   as a histogram, the worst error and the share of time spent spinning (CPU kept busy).
+*
+**********************************************************************************************/
+
+#include "bench.h"
+#include "frame_pacer.h"
+#include "threads.h"
+#include "timing.h"
+
+#include <stdio.h>          // Required for: printf()
+#include <stdlib.h>         // Required for: rand(), srand()
+
+#define BENCH_SECONDS       1           // Frames run per rate and wait method
+#define BENCH_WORK_MIN      20          // Frame work, percent of the period
+#define BENCH_WORK_MAX      60
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Busy frame work, a random share of the period
+static void RunFrameWork(unsigned long long period)
+{
+    unsigned long long work = period*(BENCH_WORK_MIN + rand()%(BENCH_WORK_MAX - BENCH_WORK_MIN + 1))/100;
+    unsigned long long end = GetTimestampNs() + work;
+
+    while (GetTimestampNs() < end) { }
+}
+
+static void PrintResult(int rate, const char *method, const int *histogram, int frames, unsigned long long maxError, double spun)
+{
+    // Buckets of 100 us, 500 us and 1 ms, see GetFramePacerBucketLimit()
+    int within[3] = { 0 };
+    const int limits[3] = { 100, 500, 1000 };
+
+    for (int b = 0; b < FRAME_PACER_BUCKETS; b++)
+    {
+        for (int l = 0; l < 3; l++)
+        {
+            if ((GetFramePacerBucketLimit(b) != -1) && (GetFramePacerBucketLimit(b) <= limits[l])) within[l] += histogram[b];
+        }
+    }
+
+    printf("%6d %8s %8d %9.1f%% %9.1f%% %9.1f%% %9.1f%% %10.3f %8.1f%%\n", rate, method, frames, 100.0*within[0]/frames, 100.0*within[1]/frames,
+           100.0*within[2]/frames, 100.0*(frames - within[2])/frames, maxError/1e6, 100.0*spun);
+}
+
+// Coarse wait: sleep the whole milliseconds left, measured like the pacer does
+static void MeasureSleep(int rate)
+{
+    unsigned long long period = 1000000000ULL/rate;
+    unsigned long long deadline = GetTimestampNs() + period;
+    unsigned long long frameStart = 0;
+    unsigned long long maxError = 0;
+    int histogram[FRAME_PACER_BUCKETS] = { 0 };
+    int frames = 0;
+
+    for (int f = 0; f <= BENCH_SECONDS*rate; f++)
+    {
+        unsigned long long now = GetTimestampNs();
+        if (deadline > now) SleepThread((int)((deadline - now)/1000000ULL));
+
+        now = GetTimestampNs();
+        deadline = ((deadline + period) > now)? deadline + period : now + period;
+
+        if (frameStart != 0)
+        {
+            unsigned long long interval = now - frameStart;
+            unsigned long long error = (interval > period)? interval - period : period - interval;
+            int bucket = 0;
+
+            while ((GetFramePacerBucketLimit(bucket) != -1) && (error > GetFramePacerBucketLimit(bucket)*1000ULL)) bucket++;
+
+            histogram[bucket]++;
+            frames++;
+            if (error > maxError) maxError = error;
+        }
+
+        frameStart = now;
+        RunFrameWork(period);
+    }
+
+    PrintResult(rate, "sleep", histogram, frames, maxError, 0.0);
+}
+
+static void MeasurePacer(int rate)
+{
+    FramePacer pacer = LoadFramePacer(rate);
+    unsigned long long start = GetTimestampNs();
+
+    for (int f = 0; f <= BENCH_SECONDS*rate; f++)
+    {
+        WaitFramePacer(&pacer);
+        RunFrameWork(pacer.period);
+    }
+
+    double spun = (double)pacer.spunNs/(GetTimestampNs() - start);
+
+    PrintResult(rate, "pacer", pacer.histogram, pacer.frames, pacer.maxError, spun);
+    printf("%6s %8s margin calibrated to %.3f ms, %d frames missed\n", "", "", pacer.margin/1e6, pacer.missed);
+
+    UnloadFramePacer(&pacer);
+}
+
+//----------------------------------------------------------------------------------
+// Benchmark Suite Definition
+//----------------------------------------------------------------------------------
+void RunPacingBenchmark(void)
+{
+    const int rates[] = { 60, 120, 144 };
+
+    srand(1234);
+
+    printf("frame work %d%% to %d%% of the period, %d s per measure\n", BENCH_WORK_MIN, BENCH_WORK_MAX, BENCH_SECONDS);
+    printf("%6s %8s %8s %10s %10s %10s %10s %10s %9s\n", "rate", "wait", "frames", "<=100us", "<=500us", "<=1ms", ">1ms", "max ms", "spun");
+
+    for (int r = 0; r < (int)(sizeof(rates)/sizeof(rates[0])); r++)
+    {
+        MeasureSleep(rates[r]);
+        MeasurePacer(rates[r]);
+    }
+}
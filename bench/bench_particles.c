@@ -0,0 +1,188 @@
+/**********************************************************************************************
+*
+*   Shooter benchmarks - Particles
+*
+*   Times MoveParticles() (SIMD path the game was built with) against MoveParticlesScalar()
+*   on the same data, ns per particle update, and checks both write the same values.
+*
+*   Then a pool is kept at about BENCH_LIVE_PARTICLES live particles, bursts spawned every
+*   tick as others expire, and whole ticks (update, swap-remove, emit) are timed on one core
+*   against the tick time.
+*
+**********************************************************************************************/
+
+#include "bench.h"
+#include "particles.h"
+#include "timing.h"
+
+#include <stdio.h>          // Required for: printf(), snprintf()
+#include <stdlib.h>         // Required for: rand(), srand()
+#include <string.h>         // Required for: memcmp()
+
+#define BENCH_PARTICLE_UPDATES  20000000    // Particle updates timed per measure
+#define BENCH_REPEATS           5           // Best of N measures is reported
+#define BENCH_TICK_TIME         (1.0f/60.0f)
+#define BENCH_LIVE_PARTICLES    100000      // Steady state target
+#define BENCH_WARMUP_TICKS      180         // Ticks before the pool is steady, longer than any life
+#define BENCH_TICKS             600         // Ticks timed in steady state
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef int (*MoveParticlesFunc)(float *positionX, float *positionY, float *velocityX, float *velocityY, float *life,
+                                 const float *inverseLife, float *alpha, int count, float dt, float damping, int *expired);
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+// One second of life on average: BENCH_LIVE_PARTICLES/60 particles spawned per tick
+static const ParticleStyle benchStyle = { 100, 6.2831853f, 60.0f, 220.0f, 0.5f, 1.5f, 3.0f, 2.0f, { 255, 150, 60, 255 } };
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Pool full of particles that outlive the measure, every update runs the same work
+static ParticlePool LoadKernelPool(int count)
+{
+    ParticleStyle style = benchStyle;
+    style.burst = 1;
+    style.lifeMin = 1.0e6f;
+    style.lifeMax = 2.0e6f;
+
+    ParticlePool pool = LoadParticlePool(style, count);
+
+    srand(1234);
+    for (int i = 0; i < count; i++)
+    {
+        Vector2 position = { (float)(rand()%800), (float)(rand()%450) };
+        EmitParticles(&pool, position, (Vector2){ 0.0f, -1.0f });
+    }
+
+    return pool;
+}
+
+// Best ns per particle over BENCH_REPEATS measures
+// NOTE: No drag, velocities damped thousands of times would end up denormal and slow every kernel down
+static double MeasureKernel(MoveParticlesFunc move, ParticlePool *pool)
+{
+    int iterations = BENCH_PARTICLE_UPDATES/pool->count;
+    double best = 0.0;
+
+    if (iterations < 1) iterations = 1;
+
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        unsigned long long start = GetTimestampNs();
+
+        for (int i = 0; i < iterations; i++)
+        {
+            move(pool->positionX, pool->positionY, pool->velocityX, pool->velocityY, pool->life,
+                 pool->inverseLife, pool->alpha, pool->count, BENCH_TICK_TIME, 1.0f, pool->expired);
+        }
+
+        double ns = (double)(GetTimestampNs() - start)/((double)iterations*pool->count);
+        if ((r == 0) || (ns < best)) best = ns;
+    }
+
+    return best;
+}
+
+// Both kernels on copies of the same particles, some of them expiring, must write the same bytes
+static bool CheckKernels(int count)
+{
+    ParticlePool a = LoadKernelPool(count);
+    ParticlePool b = LoadKernelPool(count);
+    float *arraysA[] = { a.positionX, a.positionY, a.velocityX, a.velocityY, a.life, a.alpha };
+    float *arraysB[] = { b.positionX, b.positionY, b.velocityX, b.velocityY, b.life, b.alpha };
+    bool equal = true;
+
+    for (int i = 0; i < count; i += 3) a.life[i] = b.life[i] = (i%2)? 0.01f : 0.02f;
+
+    for (int t = 0; t < 2; t++)
+    {
+        int expiredA = MoveParticles(a.positionX, a.positionY, a.velocityX, a.velocityY, a.life, a.inverseLife, a.alpha, count, BENCH_TICK_TIME, 0.95f, a.expired);
+        int expiredB = MoveParticlesScalar(b.positionX, b.positionY, b.velocityX, b.velocityY, b.life, b.inverseLife, b.alpha, count, BENCH_TICK_TIME, 0.95f, b.expired);
+
+        if ((expiredA != expiredB) || (memcmp(a.expired, b.expired, expiredA*sizeof(int)) != 0)) equal = false;
+    }
+
+    for (int i = 0; i < (int)(sizeof(arraysA)/sizeof(arraysA[0])); i++)
+    {
+        if (memcmp(arraysA[i], arraysB[i], count*sizeof(float)) != 0) equal = false;
+    }
+
+    UnloadParticlePool(&a);
+    UnloadParticlePool(&b);
+
+    return equal;
+}
+
+// Bursts every tick at random places, pool settles where spawns match expiries
+static void MeasureSteadyPool(void)
+{
+    int burstsPerTick = (int)(BENCH_LIVE_PARTICLES*BENCH_TICK_TIME/((benchStyle.lifeMin + benchStyle.lifeMax)/2.0f))/benchStyle.burst;
+    ParticlePool pool = LoadParticlePool(benchStyle, 2*BENCH_LIVE_PARTICLES);
+    unsigned long long worst = 0;
+    unsigned long long total = 0;
+    long long liveTotal = 0;
+
+    srand(1234);
+
+    for (int t = 0; t < BENCH_WARMUP_TICKS + BENCH_TICKS; t++)
+    {
+        unsigned long long start = GetTimestampNs();
+
+        UpdateParticles(&pool, BENCH_TICK_TIME);
+        for (int b = 0; b < burstsPerTick; b++)
+        {
+            Vector2 position = { (float)(rand()%800), (float)(rand()%450) };
+            EmitParticles(&pool, position, (Vector2){ 0.0f, -1.0f });
+        }
+
+        unsigned long long elapsed = GetTimestampNs() - start;
+
+        if (t >= BENCH_WARMUP_TICKS)
+        {
+            total += elapsed;
+            liveTotal += pool.count;
+            if (elapsed > worst) worst = elapsed;
+        }
+    }
+
+    double meanMs = total/1e6/BENCH_TICKS;
+
+    printf("%10.0f %10d %10d %12.3f %12.3f %9.1f%%\n", (double)liveTotal/BENCH_TICKS, burstsPerTick*benchStyle.burst, pool.droppedSpawns,
+           meanMs, worst/1e6, 100.0*meanMs/(BENCH_TICK_TIME*1e3));
+    printf("%10s %10.1fMB allocated once\n", "", GetParticlePoolMemory(&pool)/(1024.0*1024.0));
+
+    UnloadParticlePool(&pool);
+}
+
+//----------------------------------------------------------------------------------
+// Benchmark Suite Definition
+//----------------------------------------------------------------------------------
+void RunParticlesBenchmark(void)
+{
+    const int counts[] = { 1000, 10000, 100000 };
+    char simdHeader[32] = { 0 };
+
+    snprintf(simdHeader, sizeof(simdHeader), "%s ns/p", GetParticleKernelName());
+    printf("%10s %14s %14s %10s\n", "particles", "scalar ns/p", simdHeader, "speedup");
+
+    for (int c = 0; c < (int)(sizeof(counts)/sizeof(counts[0])); c++)
+    {
+        ParticlePool pool = LoadKernelPool(counts[c]);
+
+        double scalar = MeasureKernel(MoveParticlesScalar, &pool);
+        double simd = MeasureKernel(MoveParticles, &pool);
+
+        printf("%10d %14.3f %14.3f %9.2fx\n", counts[c], scalar, simd, scalar/simd);
+
+        UnloadParticlePool(&pool);
+    }
+
+    printf("kernels %s\n", CheckKernels(10007)? "match" : "DIFFER");
+
+    printf("\n%10s %10s %10s %12s %12s %10s\n", "live", "spawn/tick", "dropped", "tick ms", "worst ms", "of tick");
+    MeasureSteadyPool();
+}
@@ -0,0 +1,118 @@
+/**********************************************************************************************
+*
+*   Shooter benchmarks - Bullet pattern emitters
+*
+*   Times WriteVolleyBullets() alone, ns per bullet written, then the gameplay simulation
+*   with 1 to 32 emitters of dense patterns: spawns per tick and per second, with bullets
+*   leaving the field as fast as they are spawned.
+*
+**********************************************************************************************/
+
+#include "bench.h"
+#include "gameplay.h"
+#include "patterns.h"
+#include "timing.h"
+
+#include <stdio.h>          // Required for: printf()
+#include <stdlib.h>         // Required for: malloc(), free()
+#include <string.h>         // Required for: strlen()
+
+#define BENCH_VOLLEYS       20000           // Volleys written per kernel case
+#define BENCH_TICKS         3000            // Ticks simulated per emitters case
+#define BENCH_TICK_TIME     (1.0f/60.0f)
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static const Rectangle benchField = { 0, 0, 800, 450 };
+
+// Fast patterns, bullets are out of the field within a second
+static const char *benchPatterns =
+    "pattern spiral\n  arms 8\n  speed 600\n  spin 7\n"
+    "pattern ring\n  arms 64\n  speed 500\n  interval 2\n"
+    "pattern fan\n  count 16\n  spread 90\n  speed 550\n  speedStep 10\n  spin 3\n"
+    "pattern storm\n  arms 16\n  count 8\n  spread 20\n  speed 700\n  speedStep 15\n  spin 5\n";
+
+static const int emitterCounts[] = { 1, 8, 32 };
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static double TimeVolleys(const BulletPatterns *patterns, const BulletPattern *pattern, float *arrays)
+{
+    float *positionX = arrays;
+    float *positionY = arrays + MAX_VOLLEY_BULLETS;
+    float *directionX = arrays + 2*MAX_VOLLEY_BULLETS;
+    float *directionY = arrays + 3*MAX_VOLLEY_BULLETS;
+    float *speed = arrays + 4*MAX_VOLLEY_BULLETS;
+    Vector2 origin = { 400.0f, 100.0f };
+    Vector2 target = { 400.0f, 400.0f };
+
+    unsigned long long start = GetTimestampNs();
+
+    for (int v = 0; v < BENCH_VOLLEYS; v++)
+    {
+        Vector2 direction = GetVolleyDirection(pattern, v, origin, target);
+        WriteVolleyBullets(patterns, pattern, direction, origin, 0, pattern->count, positionX, positionY, directionX, directionY, speed);
+    }
+
+    return (double)(GetTimestampNs() - start)/BENCH_VOLLEYS/pattern->count;
+}
+
+static void RunEmitters(const BulletPatterns *patterns, int pattern, int emitterCount)
+{
+    InitGameplay(benchField);
+    SetGameplayPatterns(patterns);
+
+    // Emitters on a row along the top of the field
+    for (int i = 0; i < emitterCount; i++)
+    {
+        Vector2 position = { benchField.width*(i + 0.5f)/emitterCount, benchField.height/4 };
+        AddGameplayEmitter(pattern, position);
+    }
+
+    GameInput input = { 0 };
+    input.cursor.x = benchField.width/2;
+    unsigned long long liveBullets = 0;
+
+    unsigned long long start = GetTimestampNs();
+
+    for (int t = 0; t < BENCH_TICKS; t++)
+    {
+        UpdateGameplay(input, BENCH_TICK_TIME);
+        liveBullets += GetGameplayBulletCount();
+    }
+
+    double seconds = (GetTimestampNs() - start)/1e9;
+    int spawns = GetGameplaySpawnCount();
+
+    printf("%-8s %8d %12.1f %14.0f %12.0f %10.0f\n", patterns->patterns[pattern].name, emitterCount,
+           (double)spawns/BENCH_TICKS, spawns/seconds, BENCH_TICKS/seconds, (double)liveBullets/BENCH_TICKS);
+
+    UnloadGameplay();
+}
+
+//----------------------------------------------------------------------------------
+// Benchmark Suite Definition
+//----------------------------------------------------------------------------------
+void RunPatternsBenchmark(void)
+{
+    BulletPatterns patterns = LoadBulletPatternsFromMemory(benchPatterns, (int)strlen(benchPatterns));
+    float *arrays = (float *)malloc(5*MAX_VOLLEY_BULLETS*sizeof(float));
+
+    printf("%-8s %8s %12s\n", "pattern", "bullets", "ns/bullet");
+    for (int p = 0; p < patterns.patternCount; p++)
+    {
+        printf("%-8s %8d %12.2f\n", patterns.patterns[p].name, patterns.patterns[p].count, TimeVolleys(&patterns, &patterns.patterns[p], arrays));
+    }
+
+    printf("\n%d ticks per case\n", BENCH_TICKS);
+    printf("%-8s %8s %12s %14s %12s %10s\n", "pattern", "emitters", "spawns/tick", "spawns/s", "ticks/s", "avg live");
+    for (int p = 0; p < patterns.patternCount; p++)
+    {
+        for (int e = 0; e < (int)(sizeof(emitterCounts)/sizeof(emitterCounts[0])); e++) RunEmitters(&patterns, p, emitterCounts[e]);
+    }
+
+    free(arrays);
+    UnloadBulletPatterns(patterns);
+}
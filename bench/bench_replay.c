@@ -0,0 +1,98 @@
+/**********************************************************************************************
+*
+*   Shooter benchmarks - Recorded input replay
+*
+*   Replays an input log recorded in game (--record <file>) on the headless simulation.
+*   Emitters are set up from the patterns file as the game does (resources/patterns.txt
+*   unless another file is given), it must be the one the log was recorded with.
+*   Checks the checksum of every tick against the recorded one, then reports throughput
+*   and tick latency percentiles. Checksums are computed outside of timed sections.
+*
+**********************************************************************************************/
+
+#include "bench.h"
+#include "input_log.h"
+#include "timing.h"
+
+#include <stdio.h>          // Required for: printf()
+#include <stdlib.h>         // Required for: malloc(), free(), qsort()
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static int CompareTicks(const void *a, const void *b)
+{
+    unsigned long long ta = *(const unsigned long long *)a;
+    unsigned long long tb = *(const unsigned long long *)b;
+
+    return (ta > tb) - (ta < tb);
+}
+
+//----------------------------------------------------------------------------------
+// Benchmark Suite Definition
+//----------------------------------------------------------------------------------
+int RunReplayBenchmark(const char *fileName, const char *patternsFileName)
+{
+    if (fileName == NULL)
+    {
+        printf("Usage: shooter_bench replay <file> [patterns file]\n");
+        return 1;
+    }
+
+    InputLog log = LoadInputLog(fileName);
+
+    if (log.count == 0)
+    {
+        printf("Failed to load input log '%s'\n", fileName);
+        return 1;
+    }
+
+    unsigned long long *tickTimes = (unsigned long long *)malloc(log.count*sizeof(unsigned long long));
+    unsigned long long bulletUpdates = 0;
+    unsigned long long elapsed = 0;
+    int mismatches = 0;
+    int firstMismatch = -1;
+
+    // Game goes on without emitters when patterns are missing, so does the replay
+    BulletPatterns patterns = LoadBulletPatterns((patternsFileName != NULL)? patternsFileName : "resources/patterns.txt");
+    if (patterns.patternCount == 0) printf("No patterns loaded, replaying without emitters\n");
+
+    InitGameplay(log.field);
+    AddGameplayPatternEmitters(&patterns);
+
+    for (int t = 0; t < log.count; t++)
+    {
+        unsigned long long tickStart = GetTimestampNs();
+        UpdateGameplay(log.ticks[t].input, log.tickTime);
+        tickTimes[t] = GetTimestampNs() - tickStart;
+        elapsed += tickTimes[t];
+
+        bulletUpdates += GetGameplayBulletCount();
+
+        if (GetGameplayChecksum() != log.ticks[t].checksum)
+        {
+            if (mismatches == 0) firstMismatch = t;
+            mismatches++;
+        }
+    }
+
+    UnloadGameplay();
+    SetGameplayPatterns(NULL);
+    UnloadBulletPatterns(patterns);
+
+    qsort(tickTimes, log.count, sizeof(unsigned long long), CompareTicks);
+
+    printf("%s: %d ticks, tick latency in us\n", fileName, log.count);
+    printf("%12s %14s %10s %9s %9s %9s\n", "ticks/s", "bullets/s", "avg live", "p50", "p99", "max");
+    printf("%12.0f %14.0f %10.1f %9.2f %9.2f %9.2f\n", log.count/(elapsed/1e9), bulletUpdates/(elapsed/1e9),
+           (double)bulletUpdates/log.count, tickTimes[(int)(0.50*(log.count - 1) + 0.5)]/1000.0,
+           tickTimes[(int)(0.99*(log.count - 1) + 0.5)]/1000.0, tickTimes[log.count - 1]/1000.0);
+
+    if (mismatches == 0) printf("Checksums: all %d ticks match\n", log.count);
+    else printf("Checksums: %d ticks differ, first at tick %d (simulation diverged)\n", mismatches, firstMismatch);
+
+    free(tickTimes);
+    UnloadInputLog(log);
+
+    return (mismatches == 0)? 0 : 1;
+}
@@ -0,0 +1,195 @@
+/**********************************************************************************************
+*
+*   Shooter benchmarks - Gameplay snapshots
+*
+*   Runs a busy field (emitters, targets, player barrage) while saving every tick into a
+*   snapshot ring, with analytic and integrated projectiles. Reports snapshot size, save,
+*   push and restore times, and ring memory against keeping every snapshot whole. Then
+*   rolls back and simulates the same ticks again: states must come out byte for byte equal.
+*
+**********************************************************************************************/
+
+#include "bench.h"
+#include "gameplay.h"
+#include "snapshot.h"
+#include "timing.h"
+
+#include <math.h>           // Required for: sinf()
+#include <stdio.h>          // Required for: printf()
+#include <stdlib.h>         // Required for: malloc(), free()
+#include <string.h>         // Required for: strlen()
+
+#define BENCH_TICKS         1200            // Ticks simulated and saved per mode
+#define BENCH_TICK_TIME     (1.0f/60.0f)
+#define BENCH_RING_TICKS    120             // Ticks kept, two seconds
+#define BENCH_KEY_INTERVAL  16
+#define BENCH_RESTORES      200             // Restores timed per distance
+#define BENCH_ROLLBACK      60              // Ticks simulated again after a rollback
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static const Rectangle benchField = { 0, 0, 800, 450 };
+
+static const char *benchPatterns =
+    "pattern ring\n  arms 48\n  speed 120\n  spin 3\n  interval 6\n"
+    "pattern fan\n  count 12\n  spread 60\n  speed 160\n  aimed 1\n  interval 10\n  burst 3\n  pause 30\n";
+
+static const ProjectileMode modes[] = { PROJECTILE_ANALYTIC, PROJECTILE_INTEGRATED };
+static const char *modeNames[] = { "analytic", "integrated" };
+
+static const int restoreDistances[] = { 1, 8, BENCH_RING_TICKS - 1 };
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static GameInput ScriptInput(int tick)
+{
+    GameInput input = { 0 };
+    input.cursor.x = benchField.width/2 + sinf(tick*0.05f)*benchField.width/2;
+    input.cursor.y = benchField.height/8;
+    input.moveLeft = ((tick/90)%2) == 0;
+    input.moveRight = !input.moveLeft;
+    input.fire = true;
+
+    return input;
+}
+
+static void SetupField(const BulletPatterns *patterns)
+{
+    SetGameplayPatterns(patterns);
+
+    for (int i = 0; i < 4; i++)
+    {
+        Vector2 position = { benchField.width*(i + 0.5f)/4, benchField.height/3 };
+        AddGameplayEmitter(i%patterns->patternCount, position);
+    }
+
+    for (int column = 0; column < 16; column++)
+    {
+        Vector2 center = { 25.0f + column*50.0f, 60.0f };
+        AddGameplayTarget(center, 12.0f);
+    }
+
+    Rectangle wall = { 100.0f, 250.0f, 600.0f, 1.0f };
+    AddGameplayBoxTarget(wall);
+}
+
+// Grow buffer to the current state size
+static unsigned char *ReserveState(unsigned char *buffer, int *capacity)
+{
+    int size = GetGameplayStateSize();
+    if (size <= *capacity) return buffer;
+
+    *capacity = size*2;
+    free(buffer);
+
+    return (unsigned char *)malloc(*capacity);
+}
+
+static void RunMode(const BulletPatterns *patterns, ProjectileMode mode, const char *name)
+{
+    SetGameplayProjectileMode(mode);
+    InitGameplay(benchField);
+    SetupField(patterns);
+
+    SnapshotRing ring = LoadSnapshotRing(BENCH_RING_TICKS, BENCH_KEY_INTERVAL);
+    int capacity = 0;
+    unsigned char *state = ReserveState(NULL, &capacity);
+    unsigned char *restored = NULL;
+    unsigned long long saveTime = 0;
+    unsigned long long pushTime = 0;
+    unsigned long long stateBytes = 0;
+
+    for (int t = 0; t < BENCH_TICKS; t++)
+    {
+        UpdateGameplay(ScriptInput(GetGameplayTick()), BENCH_TICK_TIME);
+
+        state = ReserveState(state, &capacity);
+
+        unsigned long long start = GetTimestampNs();
+        int size = SaveGameplayState(state, capacity);
+        unsigned long long saved = GetTimestampNs();
+        PushSnapshot(&ring, GetGameplayTick(), state, size);
+
+        saveTime += saved - start;
+        pushTime += GetTimestampNs() - saved;
+        stateBytes += size;
+    }
+
+    int lastTick = GetGameplayTick();
+    int lastSize = GetSnapshotSize(&ring, lastTick);
+    size_t stored = GetSnapshotRingStoredSize(&ring);
+    size_t whole = 0;
+
+    for (int i = 0; i < ring.count; i++) whole += ring.entries[(ring.first + i)%ring.capacity].size;
+
+    printf("%-10s %8d %10.0f %9.1f %9.1f %10.0f %10.0f %7.1f%%\n", name, GetGameplayBulletCount(), (double)stateBytes/BENCH_TICKS,
+           saveTime/1e3/BENCH_TICKS, pushTime/1e3/BENCH_TICKS, whole/1024.0, GetSnapshotRingMemory(&ring)/1024.0, 100.0*stored/whole);
+
+    // Restore distance is what matters for deltas: one decode over the key, then the load
+    restored = (unsigned char *)malloc(capacity);
+
+    for (int d = 0; d < (int)(sizeof(restoreDistances)/sizeof(restoreDistances[0])); d++)
+    {
+        int tick = lastTick - restoreDistances[d];
+        unsigned long long decodeTime = 0;
+        unsigned long long loadTime = 0;
+
+        for (int r = 0; r < BENCH_RESTORES; r++)
+        {
+            unsigned long long start = GetTimestampNs();
+            int size = GetSnapshot(&ring, tick, restored, capacity);
+            unsigned long long decoded = GetTimestampNs();
+            LoadGameplayState(restored, size);
+
+            decodeTime += decoded - start;
+            loadTime += GetTimestampNs() - decoded;
+        }
+
+        printf("  restore %3d ticks back%s: decode %7.1f us, load %7.1f us\n", restoreDistances[d], IsSnapshotKey(&ring, tick)? " (key)" : "",
+               decodeTime/1e3/BENCH_RESTORES, loadTime/1e3/BENCH_RESTORES);
+    }
+
+    // Rollback: simulate again from an older tick, every state must match the first run
+    int from = lastTick - BENCH_ROLLBACK;
+    int difference = -1;
+    int divergedTick = -1;
+
+    LoadGameplayState(restored, GetSnapshot(&ring, from, restored, capacity));
+
+    while ((GetGameplayTick() < lastTick) && (divergedTick == -1))
+    {
+        UpdateGameplay(ScriptInput(GetGameplayTick()), BENCH_TICK_TIME);
+
+        int size = SaveGameplayState(state, capacity);
+        int expected = GetSnapshot(&ring, GetGameplayTick(), restored, capacity);
+
+        difference = FindSnapshotDifference(state, size, restored, expected);
+        if (difference != -1) divergedTick = GetGameplayTick();
+    }
+
+    if (divergedTick == -1) printf("  rollback %d ticks: states match, last snapshot %d bytes\n", BENCH_ROLLBACK, lastSize);
+    else printf("  rollback %d ticks: state of tick %d differs at byte %d\n", BENCH_ROLLBACK, divergedTick, difference);
+
+    free(restored);
+    free(state);
+    UnloadSnapshotRing(ring);
+    UnloadGameplay();
+}
+
+//----------------------------------------------------------------------------------
+// Benchmark Suite Definition
+//----------------------------------------------------------------------------------
+void RunSnapshotBenchmark(void)
+{
+    BulletPatterns patterns = LoadBulletPatternsFromMemory(benchPatterns, (int)strlen(benchPatterns));
+
+    printf("%d ticks per mode, ring of %d ticks, key every %d\n", BENCH_TICKS, BENCH_RING_TICKS, BENCH_KEY_INTERVAL);
+    printf("%-10s %8s %10s %9s %9s %10s %10s %8s\n", "mode", "bullets", "bytes", "save us", "push us", "whole KB", "ring KB", "stored");
+
+    for (int m = 0; m < (int)(sizeof(modes)/sizeof(modes[0])); m++) RunMode(&patterns, modes[m], modeNames[m]);
+
+    SetGameplayProjectileMode(PROJECTILE_ANALYTIC);
+    UnloadBulletPatterns(patterns);
+}
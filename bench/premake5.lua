@@ -0,0 +1,46 @@
+-- Headless benchmarks, built from the game sources without opening a window
+
+project (workspaceName .. "_bench")
+    kind "ConsoleApp"
+    location "../_build"
+    targetdir "../_bin/%{cfg.buildcfg}"
+
+    filter "action:vs*"
+        debugdir "$(SolutionDir)"
+
+    filter{}
+
+    vpaths
+    {
+        ["Header Files/*"] = { "**.h", "../game/src/**.h", "../game/src/**.hpp" },
+        ["Source Files/*"] = { "**.c", "**.cpp", "../game/src/**.c", "../game/src/**.cpp" },
+    }
+    files {"**.c", "**.cpp", "**.h"}
+
+    -- Game modules under test, they must not depend on a window or an audio device
+    files
+    {
+        "../game/src/arena.c",
+        "../game/src/bullets.c",
+        "../game/src/collision.c",
+        "../game/src/frame_pacer.c",
+        "../game/src/gameplay.cpp",
+        "../game/src/input_log.c",
+        "../game/src/jobs.c",
+        "../game/src/particles.c",
+        "../game/src/patterns.c",
+        "../game/src/profiler.c",
+        "../game/src/snapshot.c",
+        "../game/src/threads.c",
+        "../game/src/timing.c",
+    }
+
+    includedirs { "./" }
+    includedirs { "../game/src" }
+
+    include_raylib()
+
+    filter "system:linux"
+        links {"m", "pthread"}
+
+    filter{}
@@ -31,4 +31,7 @@ project (workspaceName)
 	
 	link_raylib()
 	
-	-- To link to a lib use link_to("LIB_FOLDER_NAME")
\ No newline at end of file
+	-- To link to a lib use link_to("LIB_FOLDER_NAME")
+    -- Pack resources/ after every build, the game maps the bundle at startup
+    dependson { workspaceName .. "_packer" }
+    postbuildcommands { "\"%{cfg.targetdir}/" .. workspaceName .. "_packer\" \"%{wks.location}/resources\" \"%{wks.location}/resources/assets.pak\"" }
@@ -0,0 +1,90 @@
+/**********************************************************************************************
+*
+*   Arena - Block based linear allocator with a memory budget
+*
+*   See arena.h for an overview.
+*
+**********************************************************************************************/
+
+#include "arena.h"
+
+#include <stdlib.h>         // Required for: malloc(), free()
+#include <string.h>         // Required for: memset()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+struct ArenaBlock {
+    ArenaBlock *next;
+    size_t size;            // Usable bytes after the header
+    size_t offset;          // Bytes handed out from this block
+    unsigned char *memory;  // Aligned start of usable bytes
+};
+
+//----------------------------------------------------------------------------------
+// Arena Functions Definition
+//----------------------------------------------------------------------------------
+void InitArena(Arena *arena, size_t blockSize, size_t budget)
+{
+    arena->blocks = NULL;
+    arena->blockSize = blockSize;
+    arena->budget = budget;
+    arena->reserved = 0;
+    arena->used = 0;
+}
+
+void UnloadArena(Arena *arena)
+{
+    ArenaBlock *block = arena->blocks;
+
+    while (block != NULL)
+    {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    arena->blocks = NULL;
+    arena->reserved = 0;
+    arena->used = 0;
+}
+
+void *ArenaAlloc(Arena *arena, size_t size)
+{
+    size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+
+    ArenaBlock *block = arena->blocks;
+
+    // Current block is full, reserve a new one within budget
+    if ((block == NULL) || ((block->size - block->offset) < size))
+    {
+        size_t blockSize = (size > arena->blockSize)? size : arena->blockSize;
+
+        if ((arena->reserved + blockSize) > arena->budget)
+        {
+            // Last block allowed by budget may be smaller than blockSize
+            if ((arena->reserved + size) > arena->budget) return NULL;
+            blockSize = arena->budget - arena->reserved;
+        }
+
+        block = (ArenaBlock *)malloc(sizeof(ArenaBlock) + blockSize + ARENA_ALIGNMENT);
+        if (block == NULL) return NULL;
+
+        size_t address = (size_t)((unsigned char *)block + sizeof(ArenaBlock));
+        block->memory = (unsigned char *)((address + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1));
+        block->size = blockSize;
+        block->offset = 0;
+        block->next = arena->blocks;
+
+        arena->blocks = block;
+        arena->reserved += blockSize;
+    }
+
+    void *memory = block->memory + block->offset;
+    block->offset += size;
+    arena->used += size;
+
+    memset(memory, 0, size);
+
+    return memory;
+}
@@ -0,0 +1,46 @@
+/**********************************************************************************************
+*
+*   Arena - Block based linear allocator with a memory budget
+*
+*   Memory is taken from the system in large blocks and handed out by bumping an offset.
+*   Single allocations are never freed, everything goes back to the system at once with
+*   UnloadArena(). Allocations beyond the budget fail instead of growing.
+*
+**********************************************************************************************/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>         // Required for: size_t
+
+#define ARENA_ALIGNMENT     64      // Allocations alignment, cache line (and AVX friendly)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct Arena {
+    ArenaBlock *blocks;     // Current block first
+    size_t blockSize;       // Minimum size of blocks requested to the system
+    size_t budget;          // Maximum bytes reserved from the system
+    size_t reserved;        // Bytes reserved from the system
+    size_t used;            // Bytes handed out
+} Arena;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Arena Functions Declaration
+//----------------------------------------------------------------------------------
+void InitArena(Arena *arena, size_t blockSize, size_t budget);
+void UnloadArena(Arena *arena);                     // Give every block back to the system
+void *ArenaAlloc(Arena *arena, size_t size);        // Zeroed memory, NULL if budget is exceeded
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ARENA_H
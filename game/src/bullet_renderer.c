@@ -0,0 +1,256 @@
+/**********************************************************************************************
+*
+*   Bullet Renderer - Batched projectile drawing
+*
+*   See bullet_renderer.h for an overview.
+*
+**********************************************************************************************/
+
+#include "bullet_renderer.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+#include <stddef.h>         // Required for: NULL
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_43)
+    #define BULLETS_INSTANCED
+#endif
+
+#define BULLET_SPRITE_SCALE         4       // Sprite is baked larger and filtered down, smoother edges
+#define BULLET_INSTANCES_PER_DRAW   16384   // Instance buffers capacity, bigger counts are drawn in several calls
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static Texture2D bulletSprite = { 0 };
+static float bulletRadius = 0.0f;
+static Color bulletColor = { 0 };
+static bool instanced = false;
+
+#if defined(BULLETS_INSTANCED)
+static Shader bulletShader = { 0 };
+static int mvpLoc = -1;
+static int radiusLoc = -1;
+static int colorLoc = -1;
+static unsigned int quadVao = 0;
+static unsigned int quadVbo = 0;
+static unsigned int instanceVboX = 0;
+static unsigned int instanceVboY = 0;
+
+// Unit quad expanded around each instance position
+static const char *bulletVertexShader =
+    "#version 330\n"
+    "in vec2 vertexPosition;\n"
+    "in float instanceX;\n"
+    "in float instanceY;\n"
+    "uniform mat4 mvp;\n"
+    "uniform float radius;\n"
+    "out vec2 fragTexCoord;\n"
+    "void main()\n"
+    "{\n"
+    "    fragTexCoord = vertexPosition*0.5 + 0.5;\n"
+    "    gl_Position = mvp*vec4(vec2(instanceX, instanceY) + vertexPosition*radius, 0.0, 1.0);\n"
+    "}\n";
+
+static const char *bulletFragmentShader =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    finalColor = texture(texture0, fragTexCoord)*colDiffuse;\n"
+    "}\n";
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void DrawBulletQuads(const float *positionX, const float *positionY, int count);
+#if defined(BULLETS_INSTANCED)
+static bool LoadInstancing(void);
+static void UnloadInstancing(void);
+static void DrawBulletInstances(const float *positionX, const float *positionY, int count);
+#endif
+
+//----------------------------------------------------------------------------------
+// Bullet Renderer Functions Definition
+//----------------------------------------------------------------------------------
+
+// Bake bullet sprite and prepare instancing when available
+void LoadBulletRenderer(float radius, Color color)
+{
+    int spriteRadius = (int)(radius*BULLET_SPRITE_SCALE);
+    Image image = GenImageColor(spriteRadius*2, spriteRadius*2, BLANK);
+    ImageDrawCircle(&image, spriteRadius, spriteRadius, spriteRadius - 1, WHITE);
+
+    bulletSprite = LoadTextureFromImage(image);
+    SetTextureFilter(bulletSprite, TEXTURE_FILTER_BILINEAR);
+    UnloadImage(image);
+
+    bulletRadius = radius;
+    bulletColor = color;
+    instanced = false;
+
+#if defined(BULLETS_INSTANCED)
+    instanced = LoadInstancing();
+    if (!instanced) TraceLog(LOG_WARNING, "BULLETS: Instancing not available, using batched quads");
+#endif
+}
+
+void UnloadBulletRenderer(void)
+{
+#if defined(BULLETS_INSTANCED)
+    if (instanced) UnloadInstancing();
+#endif
+    UnloadTexture(bulletSprite);
+    bulletSprite.id = 0;
+    instanced = false;
+}
+
+// Draw all bullets with one submission
+void DrawBulletBatch(const float *positionX, const float *positionY, int count)
+{
+    if (count <= 0) return;
+
+#if defined(BULLETS_INSTANCED)
+    if (instanced)
+    {
+        DrawBulletInstances(positionX, positionY, count);
+        return;
+    }
+#endif
+
+    DrawBulletQuads(positionX, positionY, count);
+}
+
+bool IsBulletRendererInstanced(void)
+{
+    return instanced;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Push bullets as textured quads into the active render batch, batch is only
+// flushed when full, so this is one draw call per batch size worth of bullets
+static void DrawBulletQuads(const float *positionX, const float *positionY, int count)
+{
+    float r = bulletRadius;
+
+    rlSetTexture(bulletSprite.id);
+    rlBegin(RL_QUADS);
+
+        rlColor4ub(bulletColor.r, bulletColor.g, bulletColor.b, bulletColor.a);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+
+        for (int i = 0; i < count; i++)
+        {
+            rlCheckRenderBatchLimit(4);
+
+            float x = positionX[i];
+            float y = positionY[i];
+
+            rlTexCoord2f(0.0f, 0.0f); rlVertex2f(x - r, y - r);
+            rlTexCoord2f(0.0f, 1.0f); rlVertex2f(x - r, y + r);
+            rlTexCoord2f(1.0f, 1.0f); rlVertex2f(x + r, y + r);
+            rlTexCoord2f(1.0f, 0.0f); rlVertex2f(x + r, y - r);
+        }
+
+    rlEnd();
+    rlSetTexture(0);
+}
+
+#if defined(BULLETS_INSTANCED)
+static bool LoadInstancing(void)
+{
+    bulletShader = LoadShaderFromMemory(bulletVertexShader, bulletFragmentShader);
+    if ((bulletShader.id == 0) || (bulletShader.id == rlGetShaderIdDefault())) return false;
+
+    mvpLoc = GetShaderLocation(bulletShader, "mvp");
+    radiusLoc = GetShaderLocation(bulletShader, "radius");
+    colorLoc = GetShaderLocation(bulletShader, "colDiffuse");
+    int positionLoc = GetShaderLocationAttrib(bulletShader, "vertexPosition");
+    int instanceXLoc = GetShaderLocationAttrib(bulletShader, "instanceX");
+    int instanceYLoc = GetShaderLocationAttrib(bulletShader, "instanceY");
+
+    // Two triangles covering [-1, 1]
+    const float quad[12] = { -1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f, -1.0f };
+
+    quadVao = rlLoadVertexArray();
+    rlEnableVertexArray(quadVao);
+
+        quadVbo = rlLoadVertexBuffer(quad, sizeof(quad), false);
+        rlSetVertexAttribute(positionLoc, 2, RL_FLOAT, false, 0, 0);
+        rlEnableVertexAttribute(positionLoc);
+
+        // Positions are read straight from the pool arrays, one buffer per axis
+        instanceVboX = rlLoadVertexBuffer(NULL, BULLET_INSTANCES_PER_DRAW*sizeof(float), true);
+        rlSetVertexAttribute(instanceXLoc, 1, RL_FLOAT, false, 0, 0);
+        rlSetVertexAttributeDivisor(instanceXLoc, 1);
+        rlEnableVertexAttribute(instanceXLoc);
+
+        instanceVboY = rlLoadVertexBuffer(NULL, BULLET_INSTANCES_PER_DRAW*sizeof(float), true);
+        rlSetVertexAttribute(instanceYLoc, 1, RL_FLOAT, false, 0, 0);
+        rlSetVertexAttributeDivisor(instanceYLoc, 1);
+        rlEnableVertexAttribute(instanceYLoc);
+
+    rlDisableVertexArray();
+
+    if ((quadVao == 0) || (instanceVboX == 0) || (instanceVboY == 0))
+    {
+        UnloadInstancing();
+        return false;
+    }
+
+    return true;
+}
+
+static void UnloadInstancing(void)
+{
+    rlUnloadVertexBuffer(instanceVboY);
+    rlUnloadVertexBuffer(instanceVboX);
+    rlUnloadVertexBuffer(quadVbo);
+    rlUnloadVertexArray(quadVao);
+    UnloadShader(bulletShader);
+
+    instanceVboY = 0;
+    instanceVboX = 0;
+    quadVbo = 0;
+    quadVao = 0;
+}
+
+static void DrawBulletInstances(const float *positionX, const float *positionY, int count)
+{
+    // Anything already queued must be drawn first, to keep draw order
+    rlDrawRenderBatchActive();
+
+    Matrix mvp = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+    float color[4] = { bulletColor.r/255.0f, bulletColor.g/255.0f, bulletColor.b/255.0f, bulletColor.a/255.0f };
+
+    rlEnableShader(bulletShader.id);
+    rlSetUniformMatrix(mvpLoc, mvp);
+    rlSetUniform(radiusLoc, &bulletRadius, RL_SHADER_UNIFORM_FLOAT, 1);
+    rlSetUniform(colorLoc, color, RL_SHADER_UNIFORM_VEC4, 1);
+
+    rlActiveTextureSlot(0);
+    rlEnableTexture(bulletSprite.id);
+    rlEnableVertexArray(quadVao);
+
+    for (int first = 0; first < count; first += BULLET_INSTANCES_PER_DRAW)
+    {
+        int instances = count - first;
+        if (instances > BULLET_INSTANCES_PER_DRAW) instances = BULLET_INSTANCES_PER_DRAW;
+
+        rlUpdateVertexBuffer(instanceVboX, positionX + first, instances*sizeof(float), 0);
+        rlUpdateVertexBuffer(instanceVboY, positionY + first, instances*sizeof(float), 0);
+        rlDrawVertexArrayInstanced(0, 6, instances);
+    }
+
+    rlDisableVertexArray();
+    rlDisableTexture();
+    rlDisableShader();
+}
+#endif
@@ -0,0 +1,35 @@
+/**********************************************************************************************
+*
+*   Bullet Renderer - Batched projectile drawing
+*
+*   A bullet sprite is baked into a texture once at load time, then every bullet is drawn
+*   from that texture in a single submission instead of one tessellated DrawCircle() each:
+*
+*     - OpenGL 3.3/4.3 (premake --graphics=opengl33/opengl43): one instanced draw call,
+*       bullet positions are uploaded straight from the pool arrays as per-instance data.
+*     - Other graphics APIs: textured quads pushed into the rlgl render batch.
+*
+**********************************************************************************************/
+
+#ifndef BULLET_RENDERER_H
+#define BULLET_RENDERER_H
+
+#include "raylib.h"
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Bullet Renderer Functions Declaration
+//----------------------------------------------------------------------------------
+void LoadBulletRenderer(float radius, Color color);     // Requires a window (OpenGL context)
+void UnloadBulletRenderer(void);
+void DrawBulletBatch(const float *positionX, const float *positionY, int count);
+bool IsBulletRendererInstanced(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BULLET_RENDERER_H
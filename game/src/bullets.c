@@ -0,0 +1,227 @@
+/**********************************************************************************************
+*
+*   Bullets - Projectile kernels
+*
+*   See bullets.h for an overview.
+*
+**********************************************************************************************/
+
+#include "bullets.h"
+#include "jobs.h"
+#include "threads.h"
+
+#include <limits.h>         // Required for: INT_MAX
+#include <math.h>           // Required for: floorf(), fminf(), INFINITY
+
+#if !defined(BULLETS_NO_SIMD) && defined(__AVX__)
+    #define BULLETS_SIMD_AVX
+    #include <immintrin.h>
+#elif !defined(BULLETS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+    #define BULLETS_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// MoveBullets() arguments, shared by all the ranges of a MoveBulletsParallel()
+typedef struct MoveBulletsJob {
+    float *positionX;
+    float *positionY;
+    const float *directionX;
+    const float *directionY;
+    const float *speed;
+    unsigned char *alive;
+    float dt;
+    Rectangle bounds;
+    volatile int despawned;
+} MoveBulletsJob;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void MoveBulletsRange(void *data, int start, int end);
+
+//----------------------------------------------------------------------------------
+// Bullet Kernels Definition
+//----------------------------------------------------------------------------------
+
+// Reference kernel, also used for the tail that does not fill a SIMD register
+// NOTE: Operations order matches the SIMD kernels so both give the same results
+int MoveBulletsScalar(float *positionX, float *positionY, const float *directionX, const float *directionY,
+                      const float *speed, unsigned char *alive, int count, float dt, Rectangle bounds)
+{
+    float maxX = bounds.x + bounds.width;
+    float maxY = bounds.y + bounds.height;
+    int despawned = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        float step = speed[i]*dt;
+        float x = positionX[i] + directionX[i]*step;
+        float y = positionY[i] + directionY[i]*step;
+
+        positionX[i] = x;
+        positionY[i] = y;
+
+        if (((x < bounds.x) || (x > maxX) || (y < bounds.y) || (y > maxY)) && alive[i])
+        {
+            alive[i] = 0;
+            despawned++;
+        }
+    }
+
+    return despawned;
+}
+
+int MoveBullets(float *positionX, float *positionY, const float *directionX, const float *directionY,
+                const float *speed, unsigned char *alive, int count, float dt, Rectangle bounds)
+{
+    int despawned = 0;
+    int i = 0;
+
+#if defined(BULLETS_SIMD_AVX)
+    const __m256 delta = _mm256_set1_ps(dt);
+    const __m256 minX = _mm256_set1_ps(bounds.x);
+    const __m256 minY = _mm256_set1_ps(bounds.y);
+    const __m256 maxX = _mm256_set1_ps(bounds.x + bounds.width);
+    const __m256 maxY = _mm256_set1_ps(bounds.y + bounds.height);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 step = _mm256_mul_ps(_mm256_loadu_ps(speed + i), delta);
+        __m256 x = _mm256_add_ps(_mm256_loadu_ps(positionX + i), _mm256_mul_ps(_mm256_loadu_ps(directionX + i), step));
+        __m256 y = _mm256_add_ps(_mm256_loadu_ps(positionY + i), _mm256_mul_ps(_mm256_loadu_ps(directionY + i), step));
+
+        _mm256_storeu_ps(positionX + i, x);
+        _mm256_storeu_ps(positionY + i, y);
+
+        __m256 outside = _mm256_or_ps(_mm256_or_ps(_mm256_cmp_ps(x, minX, _CMP_LT_OQ), _mm256_cmp_ps(x, maxX, _CMP_GT_OQ)),
+                                      _mm256_or_ps(_mm256_cmp_ps(y, minY, _CMP_LT_OQ), _mm256_cmp_ps(y, maxY, _CMP_GT_OQ)));
+
+        // Leaving the screen is rare, only walk lanes when some bullet did
+        int mask = _mm256_movemask_ps(outside);
+        for (int lane = 0; mask != 0; lane++, mask >>= 1)
+        {
+            if ((mask & 1) && alive[i + lane])
+            {
+                alive[i + lane] = 0;
+                despawned++;
+            }
+        }
+    }
+#elif defined(BULLETS_SIMD_SSE2)
+    const __m128 delta = _mm_set1_ps(dt);
+    const __m128 minX = _mm_set1_ps(bounds.x);
+    const __m128 minY = _mm_set1_ps(bounds.y);
+    const __m128 maxX = _mm_set1_ps(bounds.x + bounds.width);
+    const __m128 maxY = _mm_set1_ps(bounds.y + bounds.height);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 step = _mm_mul_ps(_mm_loadu_ps(speed + i), delta);
+        __m128 x = _mm_add_ps(_mm_loadu_ps(positionX + i), _mm_mul_ps(_mm_loadu_ps(directionX + i), step));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(positionY + i), _mm_mul_ps(_mm_loadu_ps(directionY + i), step));
+
+        _mm_storeu_ps(positionX + i, x);
+        _mm_storeu_ps(positionY + i, y);
+
+        __m128 outside = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(x, minX), _mm_cmpgt_ps(x, maxX)),
+                                   _mm_or_ps(_mm_cmplt_ps(y, minY), _mm_cmpgt_ps(y, maxY)));
+
+        // Leaving the screen is rare, only walk lanes when some bullet did
+        int mask = _mm_movemask_ps(outside);
+        for (int lane = 0; mask != 0; lane++, mask >>= 1)
+        {
+            if ((mask & 1) && alive[i + lane])
+            {
+                alive[i + lane] = 0;
+                despawned++;
+            }
+        }
+    }
+#endif
+
+    // Remaining bullets (all of them without SIMD)
+    despawned += MoveBulletsScalar(positionX + i, positionY + i, directionX + i, directionY + i,
+                                   speed + i, alive + i, count - i, dt, bounds);
+
+    return despawned;
+}
+
+// Split bullets in BULLETS_PER_CHUNK ranges moved across the job system threads
+int MoveBulletsParallel(float *positionX, float *positionY, const float *directionX, const float *directionY,
+                        const float *speed, unsigned char *alive, int count, float dt, Rectangle bounds)
+{
+    // Not worth waking workers for a single range
+    if (count <= BULLETS_PER_CHUNK) return MoveBullets(positionX, positionY, directionX, directionY, speed, alive, count, dt, bounds);
+
+    MoveBulletsJob job = { positionX, positionY, directionX, directionY, speed, alive, dt, bounds, 0 };
+    ParallelFor(count, BULLETS_PER_CHUNK, MoveBulletsRange, &job);
+
+    return job.despawned;
+}
+
+const char *GetBulletKernelName(void)
+{
+#if defined(BULLETS_SIMD_AVX)
+    return "AVX";
+#elif defined(BULLETS_SIMD_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+// Elapsed ticks are subtracted as integers, positions stay exact however long the game runs
+void GetBulletPositionsAt(const float *originX, const float *originY, const float *directionX, const float *directionY,
+                          const float *speed, const int *spawnTick, int count, int tick, float offset, float dt,
+                          float *positionX, float *positionY)
+{
+    for (int i = 0; i < count; i++)
+    {
+        float distance = speed[i]*(((float)(tick - spawnTick[i]) + offset)*dt);
+        positionX[i] = originX[i] + directionX[i]*distance;
+        positionY[i] = originY[i] + directionY[i]*distance;
+    }
+}
+
+// Bullet leaves bounds through the first side it reaches, same test as MoveBullets():
+// on the border is still inside
+int GetBulletExitTick(Vector2 origin, Vector2 direction, float speed, int spawnTick, float dt, Rectangle bounds)
+{
+    float maxX = bounds.x + bounds.width;
+    float maxY = bounds.y + bounds.height;
+
+    // Spawned outside, gone after its first tick
+    if ((origin.x < bounds.x) || (origin.x > maxX) || (origin.y < bounds.y) || (origin.y > maxY)) return spawnTick + 1;
+
+    float velocityX = direction.x*speed;
+    float velocityY = direction.y*speed;
+    float exitTime = INFINITY;
+
+    if (velocityX > 0.0f) exitTime = fminf(exitTime, (maxX - origin.x)/velocityX);
+    else if (velocityX < 0.0f) exitTime = fminf(exitTime, (bounds.x - origin.x)/velocityX);
+    if (velocityY > 0.0f) exitTime = fminf(exitTime, (maxY - origin.y)/velocityY);
+    else if (velocityY < 0.0f) exitTime = fminf(exitTime, (bounds.y - origin.y)/velocityY);
+
+    float ticks = floorf(exitTime/dt) + 1.0f;
+
+    if (ticks >= (float)(INT_MAX - spawnTick)) return INT_MAX;
+    return spawnTick + (int)ticks;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// One job range of a MoveBulletsParallel()
+static void MoveBulletsRange(void *data, int start, int end)
+{
+    MoveBulletsJob *job = (MoveBulletsJob *)data;
+
+    int despawned = MoveBullets(job->positionX + start, job->positionY + start, job->directionX + start, job->directionY + start,
+                                job->speed + start, job->alive + start, end - start, job->dt, job->bounds);
+
+    if (despawned > 0) AtomicAdd(&job->despawned, despawned);
+}
@@ -0,0 +1,54 @@
+/**********************************************************************************************
+*
+*   Bullets - Projectile kernels
+*
+*   Bullet fields are a structure of arrays: every field lives in its own array so
+*   MoveBullets() can integrate and bounds-check several bullets per SIMD instruction.
+*   Direction is normalized once at spawn time, no trigonometry runs per frame. Storage
+*   is owned by the caller, gameplay passes the arrays of its bullet chunks (ecs.hpp).
+*
+*   SIMD path is selected at compile time: AVX (8 bullets) if enabled, SSE2 (4 bullets) on
+*   any x86/x64 target, scalar otherwise. Define BULLETS_NO_SIMD to force the scalar path.
+*
+*   Bullets are independent, so results do not depend on how they are split across the
+*   job system threads.
+*
+**********************************************************************************************/
+
+#ifndef BULLETS_H
+#define BULLETS_H
+
+#include "raylib.h"
+
+#define BULLETS_PER_CHUNK       4096                // Bullets per job range and render batch, multiple of 8 for SIMD
+#define BULLETS_DEFAULT_BUDGET  (64*1024*1024)      // Bytes, room for about 2M bullets
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Bullet Kernels Declaration
+//----------------------------------------------------------------------------------
+// Move bullets along their direction and clear alive flag of the ones outside bounds,
+// returns the number of alive bullets that were despawned
+int MoveBullets(float *positionX, float *positionY, const float *directionX, const float *directionY,
+                const float *speed, unsigned char *alive, int count, float dt, Rectangle bounds);
+int MoveBulletsParallel(float *positionX, float *positionY, const float *directionX, const float *directionY,
+                        const float *speed, unsigned char *alive, int count, float dt, Rectangle bounds);
+int MoveBulletsScalar(float *positionX, float *positionY, const float *directionX, const float *directionY,
+                      const float *speed, unsigned char *alive, int count, float dt, Rectangle bounds);
+const char *GetBulletKernelName(void);                                                    // SIMD path MoveBullets() was built with
+
+// Closed form motion, a bullet spawned on spawnTick is at origin + direction*speed*(tick - spawnTick + offset)*dt,
+// offset in ticks places positions between ticks (render interpolation)
+void GetBulletPositionsAt(const float *originX, const float *originY, const float *directionX, const float *directionY,
+                          const float *speed, const int *spawnTick, int count, int tick, float offset, float dt,
+                          float *positionX, float *positionY);
+int GetBulletExitTick(Vector2 origin, Vector2 direction, float speed, int spawnTick, float dt, Rectangle bounds);  // First tick bullet is outside bounds, INT_MAX if never
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BULLETS_H
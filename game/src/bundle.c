@@ -0,0 +1,168 @@
+/**********************************************************************************************
+*
+*   Bundle - Packed assets, memory mapped
+*
+*   See bundle.h for an overview.
+*
+**********************************************************************************************/
+
+#include "bundle.h"
+
+#include <string.h>         // Required for: memcmp(), memchr(), strncmp()
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static bool IsEntryValid(const BundleEntry *entry, size_t bundleSize);
+
+//----------------------------------------------------------------------------------
+// Bundle Functions Definition
+//----------------------------------------------------------------------------------
+
+// Map bundle and check every entry lies inside it, entries are trusted afterwards
+Bundle LoadBundle(const char *fileName)
+{
+    Bundle bundle = { 0 };
+    MappedFile file = MapFile(fileName);
+
+    if (file.data == NULL)
+    {
+        TraceLog(LOG_WARNING, "BUNDLE: [%s] Failed to map file", fileName);
+        return bundle;
+    }
+
+    const BundleHeader *header = (const BundleHeader *)file.data;
+    bool valid = (file.size >= sizeof(BundleHeader)) && (memcmp(header->magic, "SHPK", 4) == 0) &&
+                 (header->version == BUNDLE_VERSION) &&
+                 ((file.size - sizeof(BundleHeader))/sizeof(BundleEntry) >= header->entryCount);
+
+    const BundleEntry *entries = (const BundleEntry *)(file.data + sizeof(BundleHeader));
+
+    for (unsigned int i = 0; valid && (i < header->entryCount); i++) valid = IsEntryValid(&entries[i], file.size);
+
+    if (!valid)
+    {
+        TraceLog(LOG_WARNING, "BUNDLE: [%s] Invalid or outdated bundle, rebuild it with shooter_packer", fileName);
+        UnmapFile(file);
+        return bundle;
+    }
+
+    bundle.file = file;
+    bundle.entries = entries;
+    bundle.entryCount = (int)header->entryCount;
+
+    TraceLog(LOG_INFO, "BUNDLE: [%s] Mapped %i assets (%i KB)", fileName, bundle.entryCount, (int)(file.size/1024));
+
+    return bundle;
+}
+
+void UnloadBundle(Bundle bundle)
+{
+    UnmapFile(bundle.file);
+}
+
+bool IsBundleReady(Bundle bundle)
+{
+    return (bundle.entries != NULL);
+}
+
+const BundleEntry *GetBundleEntry(Bundle bundle, const char *name)
+{
+    for (int i = 0; i < bundle.entryCount; i++)
+    {
+        if (strncmp(bundle.entries[i].name, name, BUNDLE_NAME_SIZE) == 0) return &bundle.entries[i];
+    }
+
+    return NULL;
+}
+
+Image GetBundleImage(Bundle bundle, const char *name)
+{
+    Image image = { 0 };
+    const BundleEntry *entry = GetBundleEntry(bundle, name);
+
+    if ((entry != NULL) && (entry->type == BUNDLE_ENTRY_IMAGE))
+    {
+        image.data = (void *)(bundle.file.data + entry->offset);
+        image.width = entry->params[0];
+        image.height = entry->params[1];
+        image.mipmaps = entry->params[2];
+        image.format = entry->params[3];
+    }
+    else TraceLog(LOG_WARNING, "BUNDLE: [%s] Image not found", name);
+
+    return image;
+}
+
+Wave GetBundleWave(Bundle bundle, const char *name)
+{
+    Wave wave = { 0 };
+    const BundleEntry *entry = GetBundleEntry(bundle, name);
+
+    if ((entry != NULL) && (entry->type == BUNDLE_ENTRY_WAVE))
+    {
+        wave.data = (void *)(bundle.file.data + entry->offset);
+        wave.frameCount = (unsigned int)entry->params[0];
+        wave.sampleRate = (unsigned int)entry->params[1];
+        wave.sampleSize = (unsigned int)entry->params[2];
+        wave.channels = (unsigned int)entry->params[3];
+    }
+    else TraceLog(LOG_WARNING, "BUNDLE: [%s] Wave not found", name);
+
+    return wave;
+}
+
+const unsigned char *GetBundleData(Bundle bundle, const char *name, int *dataSize)
+{
+    const BundleEntry *entry = GetBundleEntry(bundle, name);
+    *dataSize = 0;
+
+    if ((entry == NULL) || (entry->type != BUNDLE_ENTRY_RAW))
+    {
+        TraceLog(LOG_WARNING, "BUNDLE: [%s] Data not found", name);
+        return NULL;
+    }
+
+    *dataSize = (int)entry->size;
+
+    return bundle.file.data + entry->offset;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static bool IsEntryValid(const BundleEntry *entry, size_t bundleSize)
+{
+    if (memchr(entry->name, '\0', BUNDLE_NAME_SIZE) == NULL) return false;
+    if ((entry->offset%BUNDLE_ALIGNMENT) != 0) return false;
+    if ((entry->offset > bundleSize) || (entry->size > (bundleSize - entry->offset))) return false;
+
+    switch (entry->type)
+    {
+        case BUNDLE_ENTRY_RAW: return true;
+        case BUNDLE_ENTRY_IMAGE:
+        {
+            // Size of every mipmap level, as raylib expects them
+            int width = entry->params[0];
+            int height = entry->params[1];
+            int size = 0;
+
+            if ((width <= 0) || (height <= 0) || (entry->params[2] < 1)) return false;
+
+            for (int level = 0; level < entry->params[2]; level++)
+            {
+                size += GetPixelDataSize(width, height, entry->params[3]);
+                width = (width > 1)? width/2 : 1;
+                height = (height > 1)? height/2 : 1;
+            }
+
+            return ((unsigned int)size == entry->size);
+        }
+        case BUNDLE_ENTRY_WAVE:
+        {
+            unsigned int size = (unsigned int)entry->params[0]*(unsigned int)(entry->params[2]/8)*(unsigned int)entry->params[3];
+            return (size == entry->size);
+        }
+        default: return false;
+    }
+}
@@ -0,0 +1,80 @@
+/**********************************************************************************************
+*
+*   Bundle - Packed assets, memory mapped
+*
+*   shooter_packer packs resources/ into a single bundle at build time, with images and
+*   waves already decoded. At runtime the bundle is memory mapped and assets are handed to
+*   raylib as pointers into the mapping: no file is opened per asset, nothing is decoded
+*   and nothing is copied before raylib uploads or converts it.
+*
+*   Layout (native endianness, bundles are built per target):
+*     BundleHeader, BundleEntry[entryCount], entries data (BUNDLE_ALIGNMENT aligned)
+*
+*   Images keep the pixel format they were loaded with, waves keep their sample format.
+*   Other files (music streams) are stored raw, to be decoded from memory while streaming.
+*
+**********************************************************************************************/
+
+#ifndef BUNDLE_H
+#define BUNDLE_H
+
+#include "raylib.h"
+#include "mapped_file.h"
+
+#define BUNDLE_VERSION      1
+#define BUNDLE_ALIGNMENT    64          // Entries data alignment, SIMD friendly
+#define BUNDLE_NAME_SIZE    64          // Entry name, including terminator
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum BundleEntryType {
+    BUNDLE_ENTRY_RAW = 0,               // File bytes as found in resources/
+    BUNDLE_ENTRY_IMAGE,                 // Decoded pixels
+    BUNDLE_ENTRY_WAVE,                  // Decoded samples
+} BundleEntryType;
+
+typedef struct BundleHeader {
+    char magic[4];                      // "SHPK"
+    unsigned int version;
+    unsigned int entryCount;
+    unsigned int dataSize;              // Bytes after the index
+} BundleHeader;
+
+typedef struct BundleEntry {
+    char name[BUNDLE_NAME_SIZE];        // File name in resources/
+    unsigned int type;                  // BundleEntryType
+    unsigned int offset;                // Data offset from bundle start
+    unsigned int size;                  // Data size in bytes
+    int params[4];                      // Image: width, height, mipmaps, format
+                                        // Wave: frameCount, sampleRate, sampleSize, channels
+} BundleEntry;
+
+typedef struct Bundle {
+    MappedFile file;
+    const BundleEntry *entries;         // Index, inside the mapping
+    int entryCount;
+} Bundle;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Bundle Functions Declaration
+//----------------------------------------------------------------------------------
+Bundle LoadBundle(const char *fileName);                    // Map and validate bundle, no entries on failure
+void UnloadBundle(Bundle bundle);                           // Assets data handed out is not valid anymore
+bool IsBundleReady(Bundle bundle);
+const BundleEntry *GetBundleEntry(Bundle bundle, const char *name);     // NULL if not found
+
+// NOTE: Returned assets point into the mapping, they are read-only and must not be unloaded
+Image GetBundleImage(Bundle bundle, const char *name);      // Image with no data if not found
+Wave GetBundleWave(Bundle bundle, const char *name);        // Wave with no data if not found
+const unsigned char *GetBundleData(Bundle bundle, const char *name, int *dataSize);   // Raw entry bytes
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BUNDLE_H
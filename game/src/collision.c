@@ -0,0 +1,386 @@
+/**********************************************************************************************
+*
+*   Collision - Uniform grid broad-phase for bullets
+*
+*   See collision.h for an overview.
+*
+**********************************************************************************************/
+
+#include "collision.h"
+
+#include <math.h>           // Required for: sqrtf(), fabsf(), fmaxf(), fminf(), copysignf()
+#include <stdlib.h>         // Required for: calloc(), free()
+#include <string.h>         // Required for: memset(), memcpy()
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static int GetColumn(const BulletGrid *grid, float x);
+static int GetRow(const BulletGrid *grid, float y);
+static void ReserveBulletGrid(BulletGrid *grid, int capacity);
+static bool ClipSlab(float position, float motion, float extent, float *enter, float *exit);
+static float GetSweptCircleTime(float x, float y, float motionX, float motionY, float radius);
+
+//----------------------------------------------------------------------------------
+// Collision Functions Definition
+//----------------------------------------------------------------------------------
+void InitBulletGrid(BulletGrid *grid, Rectangle bounds, float cellSize, int capacity)
+{
+    memset(grid, 0, sizeof(BulletGrid));
+
+    grid->bounds = bounds;
+    grid->cellSize = cellSize;
+    grid->columns = (int)(bounds.width/cellSize) + 1;
+    grid->rows = (int)(bounds.height/cellSize) + 1;
+    grid->cellStart = (int *)calloc(grid->columns*grid->rows + 1, sizeof(int));
+    grid->cellCursor = (int *)calloc(grid->columns*grid->rows, sizeof(int));
+
+    ReserveBulletGrid(grid, capacity);
+}
+
+void UnloadBulletGrid(BulletGrid *grid)
+{
+    free(grid->cellStart);
+    free(grid->cellCursor);
+    free(grid->cellBullets);
+    free(grid->bulletCell);
+    memset(grid, 0, sizeof(BulletGrid));
+}
+
+// Bucket bullets by cell (counting sort), bullets keep their relative order inside a cell
+void BuildBulletGrid(BulletGrid *grid, const float *positionX, const float *positionY, int count)
+{
+    int cells = grid->columns*grid->rows;
+
+    if (count > grid->capacity) ReserveBulletGrid(grid, count);
+
+    memset(grid->cellStart, 0, (cells + 1)*sizeof(int));
+
+    for (int i = 0; i < count; i++)
+    {
+        int cell = GetRow(grid, positionY[i])*grid->columns + GetColumn(grid, positionX[i]);
+        grid->bulletCell[i] = cell;
+        grid->cellStart[cell + 1]++;
+    }
+
+    for (int c = 0; c < cells; c++) grid->cellStart[c + 1] += grid->cellStart[c];
+
+    memcpy(grid->cellCursor, grid->cellStart, cells*sizeof(int));
+
+    for (int i = 0; i < count; i++) grid->cellBullets[grid->cellCursor[grid->bulletCell[i]]++] = i;
+
+    grid->count = count;
+    grid->sweep = 0.0f;
+}
+
+// Bucket segments by midpoint, queries reach the longest half segment further
+void BuildSweptBulletGrid(BulletGrid *grid, const float *positionX, const float *positionY,
+                          const float *motionX, const float *motionY, int count)
+{
+    int cells = grid->columns*grid->rows;
+    float sweepSqr = 0.0f;
+
+    if (count > grid->capacity) ReserveBulletGrid(grid, count);
+
+    memset(grid->cellStart, 0, (cells + 1)*sizeof(int));
+
+    for (int i = 0; i < count; i++)
+    {
+        int cell = GetRow(grid, positionY[i] + motionY[i]*0.5f)*grid->columns + GetColumn(grid, positionX[i] + motionX[i]*0.5f);
+        grid->bulletCell[i] = cell;
+        grid->cellStart[cell + 1]++;
+
+        sweepSqr = fmaxf(sweepSqr, motionX[i]*motionX[i] + motionY[i]*motionY[i]);
+    }
+
+    for (int c = 0; c < cells; c++) grid->cellStart[c + 1] += grid->cellStart[c];
+
+    memcpy(grid->cellCursor, grid->cellStart, cells*sizeof(int));
+
+    for (int i = 0; i < count; i++) grid->cellBullets[grid->cellCursor[grid->bulletCell[i]]++] = i;
+
+    grid->count = count;
+    grid->sweep = sqrtf(sweepSqr)*0.5f;
+}
+
+int QueryBulletGrid(const BulletGrid *grid, const float *positionX, const float *positionY, float bulletRadius,
+                    Vector2 center, float radius, int *hits, int maxHits)
+{
+    float reach = radius + bulletRadius;
+    float reachSqr = reach*reach;
+    int firstColumn = GetColumn(grid, center.x - reach);
+    int lastColumn = GetColumn(grid, center.x + reach);
+    int firstRow = GetRow(grid, center.y - reach);
+    int lastRow = GetRow(grid, center.y + reach);
+    int hitsCount = 0;
+
+    for (int row = firstRow; row <= lastRow; row++)
+    {
+        // Cells of a row are contiguous, so are their bullets
+        int first = grid->cellStart[row*grid->columns + firstColumn];
+        int last = grid->cellStart[row*grid->columns + lastColumn + 1];
+
+        for (int k = first; k < last; k++)
+        {
+            int b = grid->cellBullets[k];
+            float dx = positionX[b] - center.x;
+            float dy = positionY[b] - center.y;
+
+            if ((dx*dx + dy*dy) <= reachSqr)
+            {
+                if (hitsCount < maxHits) hits[hitsCount] = b;
+                hitsCount++;
+            }
+        }
+    }
+
+    return hitsCount;
+}
+
+int CollideBulletsTargets(const BulletGrid *grid, const float *positionX, const float *positionY, float bulletRadius,
+                          const Vector2 *targetCenters, const float *targetRadii, int targetCount,
+                          CollisionHit *hits, int maxHits)
+{
+    int hitsCount = 0;
+
+    for (int t = 0; t < targetCount; t++)
+    {
+        float reach = targetRadii[t] + bulletRadius;
+        float reachSqr = reach*reach;
+        Vector2 center = targetCenters[t];
+        int firstColumn = GetColumn(grid, center.x - reach);
+        int lastColumn = GetColumn(grid, center.x + reach);
+        int firstRow = GetRow(grid, center.y - reach);
+        int lastRow = GetRow(grid, center.y + reach);
+
+        for (int row = firstRow; row <= lastRow; row++)
+        {
+            int first = grid->cellStart[row*grid->columns + firstColumn];
+            int last = grid->cellStart[row*grid->columns + lastColumn + 1];
+
+            for (int k = first; k < last; k++)
+            {
+                int b = grid->cellBullets[k];
+                float dx = positionX[b] - center.x;
+                float dy = positionY[b] - center.y;
+
+                if ((dx*dx + dy*dy) <= reachSqr)
+                {
+                    if (hitsCount < maxHits) hits[hitsCount] = (CollisionHit){ t, b, 0.0f };
+                    hitsCount++;
+                }
+            }
+        }
+    }
+
+    return hitsCount;
+}
+
+int CollideBulletsTargetsBruteForce(const float *positionX, const float *positionY, int bulletCount, float bulletRadius,
+                                    const Vector2 *targetCenters, const float *targetRadii, int targetCount,
+                                    CollisionHit *hits, int maxHits)
+{
+    int hitsCount = 0;
+
+    for (int t = 0; t < targetCount; t++)
+    {
+        float reach = targetRadii[t] + bulletRadius;
+        float reachSqr = reach*reach;
+
+        for (int b = 0; b < bulletCount; b++)
+        {
+            float dx = positionX[b] - targetCenters[t].x;
+            float dy = positionY[b] - targetCenters[t].y;
+
+            if ((dx*dx + dy*dy) <= reachSqr)
+            {
+                if (hitsCount < maxHits) hits[hitsCount] = (CollisionHit){ t, b, 0.0f };
+                hitsCount++;
+            }
+        }
+    }
+
+    return hitsCount;
+}
+
+int CollideSweptBulletsTargets(const BulletGrid *grid, const float *positionX, const float *positionY,
+                               const float *motionX, const float *motionY, float bulletRadius,
+                               const Vector2 *targetCenters, const Vector2 *targetHalfSizes, const float *targetRadii,
+                               int targetCount, CollisionHit *hits, int maxHits)
+{
+    int hitsCount = 0;
+
+    for (int t = 0; t < targetCount; t++)
+    {
+        // Segment midpoints within half a segment of the target bounds
+        float boundsX = targetHalfSizes[t].x + targetRadii[t] + bulletRadius;
+        float boundsY = targetHalfSizes[t].y + targetRadii[t] + bulletRadius;
+        float reachX = boundsX + grid->sweep;
+        float reachY = boundsY + grid->sweep;
+        Vector2 center = targetCenters[t];
+        int firstColumn = GetColumn(grid, center.x - reachX);
+        int lastColumn = GetColumn(grid, center.x + reachX);
+        int firstRow = GetRow(grid, center.y - reachY);
+        int lastRow = GetRow(grid, center.y + reachY);
+
+        for (int row = firstRow; row <= lastRow; row++)
+        {
+            int first = grid->cellStart[row*grid->columns + firstColumn];
+            int last = grid->cellStart[row*grid->columns + lastColumn + 1];
+
+            for (int k = first; k < last; k++)
+            {
+                int b = grid->cellBullets[k];
+                float halfMotionX = motionX[b]*0.5f;
+                float halfMotionY = motionY[b]*0.5f;
+
+                // Segment bounds apart from target bounds, most candidates end here
+                if ((fabsf(positionX[b] + halfMotionX - center.x) > boundsX + fabsf(halfMotionX)) ||
+                    (fabsf(positionY[b] + halfMotionY - center.y) > boundsY + fabsf(halfMotionY))) continue;
+
+                float time = GetSweptContactTime((Vector2){ positionX[b], positionY[b] }, (Vector2){ motionX[b], motionY[b] },
+                                                 bulletRadius, center, targetHalfSizes[t], targetRadii[t]);
+
+                if (time >= 0.0f)
+                {
+                    if (hitsCount < maxHits) hits[hitsCount] = (CollisionHit){ t, b, time };
+                    hitsCount++;
+                }
+            }
+        }
+    }
+
+    return hitsCount;
+}
+
+int CollideSweptBulletsTargetsBruteForce(const float *positionX, const float *positionY, const float *motionX, const float *motionY,
+                                         int bulletCount, float bulletRadius,
+                                         const Vector2 *targetCenters, const Vector2 *targetHalfSizes, const float *targetRadii,
+                                         int targetCount, CollisionHit *hits, int maxHits)
+{
+    int hitsCount = 0;
+
+    for (int t = 0; t < targetCount; t++)
+    {
+        for (int b = 0; b < bulletCount; b++)
+        {
+            float time = GetSweptContactTime((Vector2){ positionX[b], positionY[b] }, (Vector2){ motionX[b], motionY[b] },
+                                             bulletRadius, targetCenters[t], targetHalfSizes[t], targetRadii[t]);
+
+            if (time >= 0.0f)
+            {
+                if (hitsCount < maxHits) hits[hitsCount] = (CollisionHit){ t, b, time };
+                hitsCount++;
+            }
+        }
+    }
+
+    return hitsCount;
+}
+
+// Bullet circle against a rounded box is the bullet center against the box grown by both
+// radii: a slab test on the grown box, then the corner circle if entering by a corner
+float GetSweptContactTime(Vector2 position, Vector2 motion, float bulletRadius, Vector2 center, Vector2 halfSize, float radius)
+{
+    float reach = radius + bulletRadius;
+    float x = position.x - center.x;
+    float y = position.y - center.y;
+
+    // Segment bounds apart from grown box bounds
+    if ((fabsf(x + motion.x*0.5f) > halfSize.x + reach + fabsf(motion.x)*0.5f) ||
+        (fabsf(y + motion.y*0.5f) > halfSize.y + reach + fabsf(motion.y)*0.5f)) return -1.0f;
+
+    // Touching already at start
+    float outsideX = fmaxf(fabsf(x) - halfSize.x, 0.0f);
+    float outsideY = fmaxf(fabsf(y) - halfSize.y, 0.0f);
+    if ((outsideX*outsideX + outsideY*outsideY) <= reach*reach) return 0.0f;
+
+    if ((halfSize.x == 0.0f) && (halfSize.y == 0.0f)) return GetSweptCircleTime(x, y, motion.x, motion.y, reach);
+
+    float enter = 0.0f;
+    float exit = 1.0f;
+
+    if (!ClipSlab(x, motion.x, halfSize.x + reach, &enter, &exit) || !ClipSlab(y, motion.y, halfSize.y + reach, &enter, &exit)) return -1.0f;
+
+    float hitX = x + motion.x*enter;
+    float hitY = y + motion.y*enter;
+
+    // Corners of the grown box are rounded, the circle there decides
+    if ((fabsf(hitX) > halfSize.x) && (fabsf(hitY) > halfSize.y))
+    {
+        return GetSweptCircleTime(x - copysignf(halfSize.x, hitX), y - copysignf(halfSize.y, hitY), motion.x, motion.y, reach);
+    }
+
+    return enter;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Cell column of a position, positions outside the grid go to border cells
+static int GetColumn(const BulletGrid *grid, float x)
+{
+    float column = (x - grid->bounds.x)/grid->cellSize;
+
+    if (column < 0.0f) return 0;
+    if (column >= (float)grid->columns) return grid->columns - 1;
+
+    return (int)column;
+}
+
+static int GetRow(const BulletGrid *grid, float y)
+{
+    float row = (y - grid->bounds.y)/grid->cellSize;
+
+    if (row < 0.0f) return 0;
+    if (row >= (float)grid->rows) return grid->rows - 1;
+
+    return (int)row;
+}
+
+// Grow per-bullet arrays, grid contents are rebuilt on next BuildBulletGrid()
+static void ReserveBulletGrid(BulletGrid *grid, int capacity)
+{
+    if (capacity <= grid->capacity) return;
+
+    free(grid->cellBullets);
+    free(grid->bulletCell);
+
+    grid->cellBullets = (int *)calloc(capacity, sizeof(int));
+    grid->bulletCell = (int *)calloc(capacity, sizeof(int));
+    grid->capacity = capacity;
+}
+
+// Narrow [enter, exit] to the times position + motion*t is within [-extent, extent]
+static bool ClipSlab(float position, float motion, float extent, float *enter, float *exit)
+{
+    if (motion == 0.0f) return (fabsf(position) <= extent);
+
+    float t0 = (-extent - position)/motion;
+    float t1 = (extent - position)/motion;
+
+    *enter = fmaxf(*enter, fminf(t0, t1));
+    *exit = fminf(*exit, fmaxf(t0, t1));
+
+    return (*enter <= *exit);
+}
+
+// First time in [0..1] a point moving from (x, y) is within radius of the origin, -1 if none,
+// point is known to start outside
+static float GetSweptCircleTime(float x, float y, float motionX, float motionY, float radius)
+{
+    float a = motionX*motionX + motionY*motionY;
+    float b = x*motionX + y*motionY;
+    float c = x*x + y*y - radius*radius;
+
+    if (b >= 0.0f) return -1.0f;        // Not moving closer
+
+    float discriminant = b*b - a*c;
+    if (discriminant < 0.0f) return -1.0f;
+
+    float time = (-b - sqrtf(discriminant))/a;
+
+    return (time <= 1.0f)? time : -1.0f;
+}
+
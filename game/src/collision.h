@@ -0,0 +1,94 @@
+/**********************************************************************************************
+*
+*   Collision - Uniform grid broad-phase for bullets
+*
+*   Bullets are bucketed into square cells covering the play field with a counting sort,
+*   rebuilt from scratch every tick in O(bullets + cells). A circle query then only looks
+*   at bullets in the cells the circle overlaps, and the narrow phase tests those against
+*   the exact circle. Bullets outside the field are kept in the border cells.
+*
+*   Swept queries test the whole segment a bullet moves along during a tick, so fast
+*   bullets cannot skip past thin targets whatever the tick time is. The grid is then built
+*   on segment midpoints and queries reach half the longest segment further. A target is a
+*   rounded box: points within radius of a box, a circle has no size and a wall has no
+*   radius, one test covers both. Hits give the time of first contact along the segment.
+*
+**********************************************************************************************/
+
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct BulletGrid {
+    Rectangle bounds;
+    float cellSize;
+    int columns;
+    int rows;
+    int *cellStart;         // Cell c holds cellBullets[cellStart[c] .. cellStart[c + 1])
+    int *cellCursor;        // Scratch for building
+    int *cellBullets;       // Bullet indices sorted by cell
+    int *bulletCell;        // Cell of every bullet, scratch for building
+    int capacity;           // Bullets the grid can hold without growing
+    int count;              // Bullets in last build
+    float sweep;            // Longest half motion of last build, added to query reach
+} BulletGrid;
+
+// Bullet overlapping a target
+typedef struct CollisionHit {
+    int target;             // Index in targets arrays
+    int bullet;             // Dense index in bullets arrays
+    float time;             // First contact as a fraction of the motion [0..1], 0 for static tests
+} CollisionHit;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Collision Functions Declaration
+//----------------------------------------------------------------------------------
+void InitBulletGrid(BulletGrid *grid, Rectangle bounds, float cellSize, int capacity);
+void UnloadBulletGrid(BulletGrid *grid);
+void BuildBulletGrid(BulletGrid *grid, const float *positionX, const float *positionY, int count);
+
+// Bullets (of bulletRadius) overlapping a circle, returns hits count (up to maxHits written)
+int QueryBulletGrid(const BulletGrid *grid, const float *positionX, const float *positionY, float bulletRadius,
+                    Vector2 center, float radius, int *hits, int maxHits);
+
+// Every bullet/target overlapping pair, ordered by target, returns pairs count (up to maxHits written)
+int CollideBulletsTargets(const BulletGrid *grid, const float *positionX, const float *positionY, float bulletRadius,
+                          const Vector2 *targetCenters, const float *targetRadii, int targetCount,
+                          CollisionHit *hits, int maxHits);
+
+// Same result without the grid, testing every pair, reference for tests and benchmarks
+int CollideBulletsTargetsBruteForce(const float *positionX, const float *positionY, int bulletCount, float bulletRadius,
+                                    const Vector2 *targetCenters, const float *targetRadii, int targetCount,
+                                    CollisionHit *hits, int maxHits);
+
+// Bullets moving from position to position + motion, grid is bucketed by segment midpoint
+void BuildSweptBulletGrid(BulletGrid *grid, const float *positionX, const float *positionY,
+                          const float *motionX, const float *motionY, int count);
+
+// Every bullet/target pair touching during the motion, ordered by target, returns pairs count (up to maxHits written)
+// NOTE: Targets are rounded boxes, circles have a zero half size, boxes a zero radius
+int CollideSweptBulletsTargets(const BulletGrid *grid, const float *positionX, const float *positionY,
+                               const float *motionX, const float *motionY, float bulletRadius,
+                               const Vector2 *targetCenters, const Vector2 *targetHalfSizes, const float *targetRadii,
+                               int targetCount, CollisionHit *hits, int maxHits);
+int CollideSweptBulletsTargetsBruteForce(const float *positionX, const float *positionY, const float *motionX, const float *motionY,
+                                         int bulletCount, float bulletRadius,
+                                         const Vector2 *targetCenters, const Vector2 *targetHalfSizes, const float *targetRadii,
+                                         int targetCount, CollisionHit *hits, int maxHits);
+
+// First contact of a bullet moving from position by motion with a rounded box, -1 if none during the motion
+float GetSweptContactTime(Vector2 position, Vector2 motion, float bulletRadius, Vector2 center, Vector2 halfSize, float radius);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COLLISION_H
@@ -0,0 +1,161 @@
+/**********************************************************************************************
+*
+*   Compositor - Screen drawn as a stack of layers
+*
+*   See compositor.h for an overview.
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+#include "rlgl.h"           // Required for: rlSetBlendFactorsSeparate()
+#include "compositor.h"
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static int renderCount = 0;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void RenderCachedLayer(CompositorLayer *layer, int width, int height);
+
+//----------------------------------------------------------------------------------
+// Compositor Functions Definition
+//----------------------------------------------------------------------------------
+void InitCompositor(Compositor *compositor, Color background)
+{
+    *compositor = (Compositor){ 0 };
+    compositor->background = background;
+}
+
+void UnloadCompositor(Compositor *compositor)
+{
+    for (int i = 0; i < compositor->layerCount; i++)
+    {
+        if (compositor->layers[i].target.id != 0) UnloadRenderTexture(compositor->layers[i].target);
+    }
+
+    *compositor = (Compositor){ 0 };
+}
+
+int AddCompositorLayer(Compositor *compositor, LayerDrawFunc draw, bool cached)
+{
+    if (compositor->layerCount >= COMPOSITOR_MAX_LAYERS) return -1;
+
+    CompositorLayer *layer = &compositor->layers[compositor->layerCount];
+    *layer = (CompositorLayer){ 0 };
+    layer->draw = draw;
+    layer->cached = cached;
+    layer->alpha = 1.0f;
+
+    return compositor->layerCount++;
+}
+
+void InvalidateCompositorLayer(Compositor *compositor, int layer)
+{
+    if ((layer >= 0) && (layer < compositor->layerCount)) compositor->layers[layer].valid = false;
+}
+
+void SetCompositorLayerAlpha(Compositor *compositor, int layer, float alpha)
+{
+    if ((layer >= 0) && (layer < compositor->layerCount)) compositor->layers[layer].alpha = alpha;
+}
+
+void DrawCompositor(Compositor *compositor)
+{
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+
+    // Cached content has the old window size, textures are created again on demand
+    if ((width != compositor->width) || (height != compositor->height))
+    {
+        for (int i = 0; i < compositor->layerCount; i++)
+        {
+            CompositorLayer *layer = &compositor->layers[i];
+
+            if (layer->target.id != 0) UnloadRenderTexture(layer->target);
+            layer->target = (RenderTexture2D){ 0 };
+            layer->valid = false;
+        }
+
+        compositor->width = width;
+        compositor->height = height;
+    }
+
+    ClearBackground(compositor->background);
+
+    for (int i = 0; i < compositor->layerCount; i++)
+    {
+        CompositorLayer *layer = &compositor->layers[i];
+
+        if (!layer->cached)
+        {
+            layer->draw();
+            continue;
+        }
+
+        if (!layer->valid) RenderCachedLayer(layer, width, height);
+
+        if (layer->target.id == 0) layer->draw();      // No render texture support
+        else if (layer->alpha > 0.0f)
+        {
+            // NOTE: Premultiplied content, every tint channel scales with alpha
+            unsigned char value = (unsigned char)(255.0f*((layer->alpha < 1.0f)? layer->alpha : 1.0f));
+            Color tint = { value, value, value, value };
+
+            // Render texture is stored upside down, source height is negative to flip it
+            BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+            DrawTextureRec(layer->target.texture, (Rectangle){ 0, 0, (float)width, -(float)height }, (Vector2){ 0, 0 }, tint);
+            EndBlendMode();
+        }
+    }
+}
+
+int GetCompositorRenderCount(void)
+{
+    return renderCount;
+}
+
+// RGBA8 color texture and depth renderbuffer (24 bits, stored as 32) per render texture
+size_t GetCompositorMemory(const Compositor *compositor)
+{
+    size_t memory = 0;
+
+    for (int i = 0; i < compositor->layerCount; i++)
+    {
+        const RenderTexture2D *target = &compositor->layers[i].target;
+        if (target->id != 0) memory += (size_t)target->texture.width*target->texture.height*(4 + 4);
+    }
+
+    return memory;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static void RenderCachedLayer(CompositorLayer *layer, int width, int height)
+{
+    if (layer->target.id == 0)
+    {
+        layer->target = LoadRenderTexture(width, height);
+
+        if (layer->target.id == 0)
+        {
+            layer->valid = true;    // Drawn directly, do not try again until resized
+            return;
+        }
+    }
+
+    // Color is blended, alpha accumulates coverage, content ends up premultiplied
+    BeginTextureMode(layer->target);
+        ClearBackground(BLANK);
+        rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+        layer->draw();
+        EndBlendMode();
+    EndTextureMode();
+
+    layer->valid = true;
+    renderCount++;
+}
@@ -0,0 +1,67 @@
+/**********************************************************************************************
+*
+*   Compositor - Screen drawn as a stack of layers
+*
+*   A screen is cleared to its background color (no fill cost) and its layers are drawn in
+*   order on top. Cached layers are rendered once into a screen sized render texture and
+*   blitted afterwards, they are rendered again only when invalidated or when the window
+*   size changes. Dynamic layers draw straight to the screen every frame.
+*
+*   Layers are rendered with premultiplied alpha and blitted with BLEND_ALPHA_PREMULTIPLY,
+*   so a cached layer looks the same as drawn directly, and it can be faded as a whole.
+*
+*   Without render texture support (OpenGL 1.1) cached layers are drawn directly, unfaded.
+*
+**********************************************************************************************/
+
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include "raylib.h"
+
+#include <stddef.h>         // Required for: size_t
+
+#define COMPOSITOR_MAX_LAYERS   8
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef void (*LayerDrawFunc)(void);
+
+typedef struct CompositorLayer {
+    LayerDrawFunc draw;
+    bool cached;
+    bool valid;                 // Render texture holds current content
+    float alpha;                // Cached layers only, applied when blitting
+    RenderTexture2D target;
+} CompositorLayer;
+
+typedef struct Compositor {
+    Color background;
+    CompositorLayer layers[COMPOSITOR_MAX_LAYERS];
+    int layerCount;
+    int width;                  // Size cached layers were rendered at
+    int height;
+} Compositor;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Compositor Functions Declaration
+//----------------------------------------------------------------------------------
+void InitCompositor(Compositor *compositor, Color background);
+void UnloadCompositor(Compositor *compositor);
+int AddCompositorLayer(Compositor *compositor, LayerDrawFunc draw, bool cached);   // Returns layer index, -1 on failure
+void InvalidateCompositorLayer(Compositor *compositor, int layer);     // Render cached layer again on next draw
+void SetCompositorLayerAlpha(Compositor *compositor, int layer, float alpha);
+void DrawCompositor(Compositor *compositor);
+int GetCompositorRenderCount(void);     // Cached layer renders, all compositors
+size_t GetCompositorMemory(const Compositor *compositor);   // Video memory of cached layers, color and depth buffers
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMPOSITOR_H
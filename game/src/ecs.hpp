@@ -0,0 +1,785 @@
+/**********************************************************************************************
+*
+*   ECS - Archetype based entity-component storage
+*
+*   An entity is a generational handle, its data lives in components: plain structs that
+*   can be copied with memcpy(). Entities with the same set of components share an archetype,
+*   stored in chunks of ECS_CHUNK_SIZE bytes. A chunk holds one contiguous array per
+*   component (plus the entity handles), each array aligned to a cache line, so a query walks
+*   plain arrays and a system can hand them straight to SIMD kernels.
+*
+*   Archetypes keep their entities packed: entity index i lives in chunk i/capacity, only
+*   the last chunk is partially filled. Destroy() only flags an entity, FlushDestroyed()
+*   swap-removes flagged entities in ascending index order, so nothing moves while a query
+*   is running and the resulting order only depends on what was destroyed. Flushing costs
+*   O(flagged), entities that stay are not visited.
+*
+*   Chunks come from an arena capped by the budget given to Init(), chunks emptied by
+*   removals are kept for reuse. Creates beyond the budget fail and are counted.
+*
+*   SaveState() writes slots, then every chunk of every archetype with its arrays packed
+*   one after another, each padded with zeros up to a power of two entities (or capacity):
+*   equal worlds give equal bytes whatever memory they sit in, and arrays stay at the same
+*   offset while entities come and go, so two states of nearby ticks mostly differ where
+*   entities did. LoadState() copies them back into chunks of the world it is called on.
+*   Component ids are given in order of first use, which depends on the code path taken and
+*   on the build: states are only valid in the binary that saved them, and at most
+*   ECS_MAX_COMPONENTS component types can be used (asserted).
+*
+*   NOTE: Header only, C++17. A world is not thread safe, queries may be split across
+*   threads as long as every thread works on different chunks.
+*
+**********************************************************************************************/
+
+#ifndef ECS_HPP
+#define ECS_HPP
+
+#include "arena.h"
+
+#include <algorithm>        // Required for: std::sort()
+#include <atomic>           // Required for: std::atomic
+#include <cassert>          // Required for: assert()
+#include <cstdint>          // Required for: uint64_t
+#include <cstring>          // Required for: memcpy()
+#include <deque>            // Required for: std::deque
+#include <type_traits>      // Required for: std::is_trivially_copyable
+#include <vector>           // Required for: std::vector
+
+#define ECS_CHUNK_SIZE          (64*1024)           // Bytes, entities per chunk depend on archetype components
+#define ECS_MAX_CHUNK_ENTITIES  4096                // Multiple of 8, SIMD kernels can run over whole chunks
+#define ECS_MAX_COMPONENTS      64                  // Component types, one bit each in archetype masks
+#define ECS_ARENA_BLOCK         (4*1024*1024)       // Bytes reserved from the system at once
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Generational handle, stays safe to use after the entity is gone
+struct Entity {
+    int slot;
+    unsigned int generation;
+};
+
+static const Entity INVALID_ENTITY = { -1, 0 };
+
+typedef uint64_t ComponentMask;
+
+struct EcsArchetype {
+    ComponentMask mask;
+    int capacity;                               // Entities per chunk
+    int count;                                  // Entities stored, alive or pending removal
+    int componentCount;
+    int components[ECS_MAX_COMPONENTS];         // Component ids, in id order
+    int offsets[ECS_MAX_COMPONENTS];            // Byte offset of component array in chunk, by id, -1 if missing
+    int sizes[ECS_MAX_COMPONENTS];              // Component size, by id
+    std::vector<unsigned char *> chunks;        // Entity handles array first, then component arrays
+};
+
+// Filled part of one chunk, as listed by a query
+struct EcsChunkView {
+    const EcsArchetype *archetype;
+    unsigned char *data;
+    int count;                                  // Entities in chunk
+    int first;                                  // Query position of first entity, views are in query order
+
+    template<typename T> T *Get() const;        // Component array, T must be in the query
+    const Entity *GetEntities() const { return (const Entity *)data; }
+};
+
+// Component type ids, given in order of first use, one bit each in ComponentMask
+inline int NextComponentId()
+{
+    static std::atomic<int> count(0);
+    return count++;
+}
+
+template<typename T>
+int GetComponentId()
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Components are moved with memcpy()");
+    static const int id = NextComponentId();
+    assert((id < ECS_MAX_COMPONENTS) && "Too many component types for ComponentMask");
+    return id;
+}
+
+template<typename... Ts>
+ComponentMask GetComponentMask()
+{
+    return (ComponentMask(0) | ... | (ComponentMask(1) << GetComponentId<Ts>()));
+}
+
+template<typename T>
+T *EcsChunkView::Get() const
+{
+    return (T *)(data + archetype->offsets[GetComponentId<T>()]);
+}
+
+class EcsWorld {
+public:
+    void Init(size_t budget);                   // Budget in bytes for chunk memory
+    void Unload();                              // Give memory back, every entity is gone
+
+    template<typename... Ts> Entity Create(const Ts &...components);   // Returns INVALID_ENTITY if budget is reached
+    template<typename... Ts, typename Func> int CreateBatch(int count, Func fill);  // fill(int first, int count, const Entity *entities, Ts *...arrays), returns entities created
+    void Destroy(Entity entity);                // Flag entity, removed on FlushDestroyed()
+    void FlushDestroyed();                      // Remove flagged entities, never call it while iterating
+    bool IsAlive(Entity entity) const;          // False once destroyed, even before flush
+    template<typename T> T *Get(Entity entity); // NULL if entity is gone or has no T
+
+    template<typename... Ts> void Query(std::vector<EcsChunkView> &views);   // Chunks of entities having every Ts
+    template<typename... Ts, typename Func> void ForEachChunk(Func func);   // func(int count, Ts *...arrays)
+    template<typename... Ts, typename Func> void ForEach(Func func);        // func(Ts &...components)
+    template<typename... Ts> int Count() const; // Entities having every Ts, pending removal included
+
+    size_t GetStateSize() const;                // Bytes SaveState() writes
+    size_t SaveState(unsigned char *data) const;    // Returns bytes written, flagged entities are saved alive: flush first
+    bool LoadState(const unsigned char *data, size_t size);     // Replace every entity, false if data is not valid or budget is reached
+
+    int GetDroppedCreates() const { return droppedCreates; }
+    size_t GetMemory() const;                   // Bytes reserved from the system
+
+private:
+    struct EcsRecord {
+        int archetype;                          // -1 if slot is free
+        int index;                              // Index in archetype, or next free slot
+        unsigned int generation;                // Bumped every time slot is released
+        bool pending;                           // Flagged by Destroy()
+    };
+
+    int FindArchetype(const int *ids, const int *sizes, int count);
+    void Clear();                               // Remove every entity, chunks are kept for reuse
+    static int GetSavedCount(const EcsArchetype &archetype, int remaining);    // Array length of a chunk in saved states
+    int AddEntity(int archetype, int *index);   // Returns slot, -1 if budget is reached
+    void MoveEntity(EcsArchetype &archetype, int from, int to);
+    unsigned char *GetChunk(const EcsArchetype &archetype, int index) const { return archetype.chunks[index/archetype.capacity]; }
+
+    Arena arena = {};
+    std::deque<EcsArchetype> archetypes;        // Deque, views keep pointers to archetypes
+    std::vector<EcsRecord> records;
+    std::vector<unsigned char *> freeChunks;    // Emptied chunks, ready for reuse
+    std::vector<int> pendingSlots;              // Flagged by Destroy(), in call order
+    int freeSlot = -1;
+    int droppedCreates = 0;
+};
+
+//----------------------------------------------------------------------------------
+// ECS World Functions Definition
+//----------------------------------------------------------------------------------
+inline void EcsWorld::Init(size_t budget)
+{
+    Unload();
+    InitArena(&arena, ECS_ARENA_BLOCK, budget);
+}
+
+inline void EcsWorld::Unload()
+{
+    UnloadArena(&arena);
+
+    // Swapped with empty containers, clear() alone keeps the memory
+    std::deque<EcsArchetype>().swap(archetypes);
+    std::vector<EcsRecord>().swap(records);
+    std::vector<unsigned char *>().swap(freeChunks);
+    std::vector<int>().swap(pendingSlots);
+    freeSlot = -1;
+    droppedCreates = 0;
+}
+
+template<typename... Ts>
+Entity EcsWorld::Create(const Ts &...components)
+{
+    static_assert(sizeof...(Ts) > 0, "Entities need at least one component");
+
+    const int ids[] = { GetComponentId<Ts>()... };
+    const int sizes[] = { (int)sizeof(Ts)... };
+
+    int archetypeIndex = FindArchetype(ids, sizes, (int)sizeof...(Ts));
+    int index = 0;
+    int slot = AddEntity(archetypeIndex, &index);
+
+    if (slot == -1)
+    {
+        droppedCreates++;
+        return INVALID_ENTITY;
+    }
+
+    EcsArchetype &archetype = archetypes[archetypeIndex];
+    unsigned char *chunk = GetChunk(archetype, index);
+    int i = index%archetype.capacity;
+
+    Entity entity = { slot, records[slot].generation };
+    ((Entity *)chunk)[i] = entity;
+    (memcpy(chunk + archetype.offsets[GetComponentId<Ts>()] + i*sizeof(Ts), &components, sizeof(Ts)), ...);
+
+    return entity;
+}
+
+// Create entities with uninitialized components, fill() writes them one chunk span at a time
+// NOTE: Spans are given in creation order, first is the position of the span in the batch
+template<typename... Ts, typename Func>
+int EcsWorld::CreateBatch(int count, Func fill)
+{
+    static_assert(sizeof...(Ts) > 0, "Entities need at least one component");
+
+    const int ids[] = { GetComponentId<Ts>()... };
+    const int sizes[] = { (int)sizeof(Ts)... };
+
+    int archetypeIndex = FindArchetype(ids, sizes, (int)sizeof...(Ts));
+    int created = 0;
+
+    while (created < count)
+    {
+        // First entity of a span may need a new chunk, the others fit in it
+        int index = 0;
+        int slot = AddEntity(archetypeIndex, &index);
+        if (slot == -1) break;
+
+        EcsArchetype &archetype = archetypes[archetypeIndex];
+        unsigned char *chunk = GetChunk(archetype, index);
+        int start = index%archetype.capacity;
+        int span = archetype.capacity - start;
+        if (span > count - created) span = count - created;
+
+        Entity *entities = (Entity *)chunk + start;
+        entities[0] = Entity{ slot, records[slot].generation };
+
+        for (int i = 1; i < span; i++)
+        {
+            slot = AddEntity(archetypeIndex, &index);
+            entities[i] = Entity{ slot, records[slot].generation };
+        }
+
+        fill(created, span, (const Entity *)entities, (Ts *)(chunk + archetype.offsets[GetComponentId<Ts>()]) + start...);
+        created += span;
+    }
+
+    droppedCreates += count - created;
+
+    return created;
+}
+
+inline void EcsWorld::Destroy(Entity entity)
+{
+    if (!IsAlive(entity)) return;
+
+    records[entity.slot].pending = true;
+    pendingSlots.push_back(entity.slot);
+}
+
+// Swap-remove flagged entities, O(flagged log flagged)
+// NOTE: Entities order is not preserved, last one of the archetype fills the hole
+inline void EcsWorld::FlushDestroyed()
+{
+    if (pendingSlots.empty()) return;
+
+    // Lowest index first whatever order Destroy() was called in
+    std::sort(pendingSlots.begin(), pendingSlots.end(), [this](int a, int b)
+    {
+        return (records[a].archetype < records[b].archetype) ||
+               ((records[a].archetype == records[b].archetype) && (records[a].index < records[b].index));
+    });
+
+    for (int pendingSlot : pendingSlots)
+    {
+        // Gone already, it was last of its archetype and got moved into an earlier hole
+        if (!records[pendingSlot].pending) continue;
+
+        EcsArchetype &archetype = archetypes[records[pendingSlot].archetype];
+        int index = records[pendingSlot].index;
+
+        // Remove flagged entity at index, then the one moved into the hole if flagged too
+        while (index < archetype.count)
+        {
+            int slot = ((const Entity *)GetChunk(archetype, index))[index%archetype.capacity].slot;
+            EcsRecord &record = records[slot];
+
+            if (!record.pending) break;
+
+            // Release slot, older handles become stale
+            record.archetype = -1;
+            record.index = freeSlot;
+            record.generation++;
+            record.pending = false;
+            freeSlot = slot;
+
+            int last = --archetype.count;
+            if (index != last) MoveEntity(archetype, last, index);
+
+            if ((int)archetype.chunks.size()*archetype.capacity - archetype.count == archetype.capacity)
+            {
+                freeChunks.push_back(archetype.chunks.back());
+                archetype.chunks.pop_back();
+            }
+        }
+    }
+
+    pendingSlots.clear();
+}
+
+inline bool EcsWorld::IsAlive(Entity entity) const
+{
+    if ((entity.slot < 0) || (entity.slot >= (int)records.size())) return false;
+
+    const EcsRecord &record = records[entity.slot];
+    return (record.archetype != -1) && (record.generation == entity.generation) && !record.pending;
+}
+
+template<typename T>
+T *EcsWorld::Get(Entity entity)
+{
+    if (!IsAlive(entity)) return NULL;
+
+    const EcsRecord &record = records[entity.slot];
+    const EcsArchetype &archetype = archetypes[record.archetype];
+    int offset = archetype.offsets[GetComponentId<T>()];
+
+    if (offset == -1) return NULL;
+    return (T *)(GetChunk(archetype, record.index) + offset) + record.index%archetype.capacity;
+}
+
+// List chunks of matching archetypes, views stay valid until entities are created or flushed
+template<typename... Ts>
+void EcsWorld::Query(std::vector<EcsChunkView> &views)
+{
+    ComponentMask mask = GetComponentMask<Ts...>();
+    int first = 0;
+
+    views.clear();
+
+    for (const EcsArchetype &archetype : archetypes)
+    {
+        if ((archetype.mask & mask) != mask) continue;
+
+        for (int c = 0; c*archetype.capacity < archetype.count; c++)
+        {
+            int count = archetype.count - c*archetype.capacity;
+            if (count > archetype.capacity) count = archetype.capacity;
+
+            views.push_back({ &archetype, archetype.chunks[c], count, first });
+            first += count;
+        }
+    }
+}
+
+template<typename... Ts, typename Func>
+void EcsWorld::ForEachChunk(Func func)
+{
+    ComponentMask mask = GetComponentMask<Ts...>();
+
+    for (const EcsArchetype &archetype : archetypes)
+    {
+        if ((archetype.mask & mask) != mask) continue;
+
+        for (int c = 0; c*archetype.capacity < archetype.count; c++)
+        {
+            int count = archetype.count - c*archetype.capacity;
+            if (count > archetype.capacity) count = archetype.capacity;
+
+            func(count, (Ts *)(archetype.chunks[c] + archetype.offsets[GetComponentId<Ts>()])...);
+        }
+    }
+}
+
+template<typename... Ts, typename Func>
+void EcsWorld::ForEach(Func func)
+{
+    ForEachChunk<Ts...>([&func](int count, Ts *...arrays)
+    {
+        for (int i = 0; i < count; i++) func(arrays[i]...);
+    });
+}
+
+template<typename... Ts>
+int EcsWorld::Count() const
+{
+    ComponentMask mask = GetComponentMask<Ts...>();
+    int count = 0;
+
+    for (const EcsArchetype &archetype : archetypes)
+    {
+        if ((archetype.mask & mask) == mask) count += archetype.count;
+    }
+
+    return count;
+}
+
+inline size_t EcsWorld::GetMemory() const
+{
+    size_t memory = arena.reserved + records.capacity()*sizeof(EcsRecord) + pendingSlots.capacity()*sizeof(int);
+
+    for (const EcsArchetype &archetype : archetypes) memory += sizeof(EcsArchetype) + archetype.chunks.capacity()*sizeof(unsigned char *);
+
+    return memory;
+}
+
+// Saved state, native byte order:
+//   int recordCount, int freeSlot, int droppedCreates, int archetypeCount
+//   per record: int archetype, int index, unsigned int generation
+//   per archetype: ComponentMask mask, int count, int componentCount, (int id, int size) per component,
+//   then per used chunk: entity handles and every component array, GetSavedCount() elements each
+inline size_t EcsWorld::GetStateSize() const
+{
+    size_t size = 4*sizeof(int) + records.size()*3*sizeof(int);
+
+    for (const EcsArchetype &archetype : archetypes)
+    {
+        size_t entityBytes = sizeof(Entity);
+        for (int i = 0; i < archetype.componentCount; i++) entityBytes += archetype.sizes[archetype.components[i]];
+
+        size += sizeof(ComponentMask) + (2 + 2*(size_t)archetype.componentCount)*sizeof(int);
+
+        for (int c = 0; c*archetype.capacity < archetype.count; c++) size += (size_t)GetSavedCount(archetype, archetype.count - c*archetype.capacity)*entityBytes;
+    }
+
+    return size;
+}
+
+inline size_t EcsWorld::SaveState(unsigned char *data) const
+{
+    unsigned char *start = data;
+    auto write = [&data](const void *value, size_t size)
+    {
+        memcpy(data, value, size);
+        data += size;
+    };
+
+    // Filled part of a chunk array, then zeros up to saved count
+    auto writeArray = [&data](const unsigned char *array, int count, int saved, int elementSize)
+    {
+        memcpy(data, array, (size_t)count*elementSize);
+        memset(data + (size_t)count*elementSize, 0, (size_t)(saved - count)*elementSize);
+        data += (size_t)saved*elementSize;
+    };
+
+    int header[4] = { (int)records.size(), freeSlot, droppedCreates, (int)archetypes.size() };
+    write(header, sizeof(header));
+
+    // NOTE: Records are written field by field, padding bytes would make equal states differ
+    for (const EcsRecord &record : records)
+    {
+        int fields[3] = { record.archetype, record.index, (int)record.generation };
+        write(fields, sizeof(fields));
+    }
+
+    for (const EcsArchetype &archetype : archetypes)
+    {
+        int counts[2] = { archetype.count, archetype.componentCount };
+        write(&archetype.mask, sizeof(ComponentMask));
+        write(counts, sizeof(counts));
+
+        for (int i = 0; i < archetype.componentCount; i++)
+        {
+            int component[2] = { archetype.components[i], archetype.sizes[archetype.components[i]] };
+            write(component, sizeof(component));
+        }
+
+        for (int c = 0; c*archetype.capacity < archetype.count; c++)
+        {
+            int saved = GetSavedCount(archetype, archetype.count - c*archetype.capacity);
+            int count = (archetype.count - c*archetype.capacity < saved)? archetype.count - c*archetype.capacity : saved;
+
+            writeArray(archetype.chunks[c], count, saved, (int)sizeof(Entity));
+
+            for (int i = 0; i < archetype.componentCount; i++)
+            {
+                int id = archetype.components[i];
+                writeArray(archetype.chunks[c] + archetype.offsets[id], count, saved, archetype.sizes[id]);
+            }
+        }
+    }
+
+    return (size_t)(data - start);
+}
+
+// Archetypes are rebuilt in saved order, queries list chunks in that order
+// NOTE: On failure the world is left empty
+inline bool EcsWorld::LoadState(const unsigned char *data, size_t size)
+{
+    size_t position = 0;
+    auto read = [&](void *value, size_t bytes)
+    {
+        if (bytes > size - position) return false;
+
+        memcpy(value, data + position, bytes);
+        position += bytes;
+        return true;
+    };
+
+    auto skip = [&](size_t bytes)
+    {
+        if (bytes > size - position) return false;
+
+        position += bytes;
+        return true;
+    };
+
+    // Chunk arrays, padding past the last entity is skipped
+    auto readChunks = [&](EcsArchetype &archetype)
+    {
+        for (int c = 0; c*archetype.capacity < archetype.count; c++)
+        {
+            int saved = GetSavedCount(archetype, archetype.count - c*archetype.capacity);
+            int count = (archetype.count - c*archetype.capacity < saved)? archetype.count - c*archetype.capacity : saved;
+
+            if (!read(archetype.chunks[c], (size_t)count*sizeof(Entity)) || !skip((size_t)(saved - count)*sizeof(Entity))) return false;
+
+            for (int i = 0; i < archetype.componentCount; i++)
+            {
+                int id = archetype.components[i];
+
+                if (!read(archetype.chunks[c] + archetype.offsets[id], (size_t)count*archetype.sizes[id]) ||
+                    !skip((size_t)(saved - count)*archetype.sizes[id])) return false;
+            }
+        }
+
+        return true;
+    };
+
+    Clear();
+
+    int header[4] = { 0 };
+    if (!read(header, sizeof(header)) || (header[0] < 0) || (header[3] < 0) ||
+        ((size_t)header[0] > (size - position)/(3*sizeof(int)))) return false;
+
+    records.resize(header[0]);
+
+    for (EcsRecord &record : records)
+    {
+        int fields[3] = { 0 };
+        read(fields, sizeof(fields));
+        record = { fields[0], fields[1], (unsigned int)fields[2], false };
+    }
+
+    int loaded = 0;
+
+    for (int a = 0; a < header[3]; a++)
+    {
+        ComponentMask mask = 0;
+        int counts[2] = { 0 };
+        int ids[ECS_MAX_COMPONENTS] = { 0 };
+        int sizes[ECS_MAX_COMPONENTS] = { 0 };
+        bool valid = read(&mask, sizeof(ComponentMask)) && read(counts, sizeof(counts)) &&
+                     (counts[0] >= 0) && (counts[1] > 0) && (counts[1] <= ECS_MAX_COMPONENTS);
+
+        for (int i = 0; valid && (i < counts[1]); i++)
+        {
+            int component[2] = { 0 };
+            valid = read(component, sizeof(component)) && (component[0] >= 0) && (component[0] < ECS_MAX_COMPONENTS) && (component[1] > 0);
+            ids[i] = component[0];
+            sizes[i] = component[1];
+        }
+
+        if (!valid) break;
+
+        // Same archetype at the same place is kept as is, anything else is dropped from here on
+        if ((a >= (int)archetypes.size()) || (archetypes[a].mask != mask))
+        {
+            archetypes.resize(a);
+            if (FindArchetype(ids, sizes, counts[1]) != a) break;
+        }
+
+        EcsArchetype &archetype = archetypes[a];
+        if ((archetype.mask != mask) || (archetype.componentCount != counts[1])) break;
+        for (int i = 0; valid && (i < counts[1]); i++) valid = (archetype.sizes[ids[i]] == sizes[i]);
+
+        while (valid && ((int)archetype.chunks.size()*archetype.capacity < counts[0]))
+        {
+            unsigned char *chunk = NULL;
+
+            if (!freeChunks.empty())
+            {
+                chunk = freeChunks.back();
+                freeChunks.pop_back();
+            }
+            else chunk = (unsigned char *)ArenaAlloc(&arena, ECS_CHUNK_SIZE);
+
+            if (chunk == NULL) valid = false;
+            else archetype.chunks.push_back(chunk);
+        }
+
+        archetype.count = counts[0];
+        valid = valid && readChunks(archetype);
+
+        if (!valid)
+        {
+            archetype.count = 0;
+            break;
+        }
+
+        loaded++;
+    }
+
+    if (loaded == header[3]) archetypes.resize(loaded);
+
+    // Records and entity handles must point at each other, free slots must chain to -1 without a loop
+    bool valid = (position == size) && (loaded == header[3]) && (header[1] >= -1) && (header[1] < header[0]);
+    int aliveRecords = 0;
+    int freeRecords = 0;
+    int entityCount = 0;
+
+    for (int slot = 0; valid && (slot < header[0]); slot++)
+    {
+        const EcsRecord &record = records[slot];
+
+        if (record.archetype == -1)
+        {
+            valid = (record.index >= -1) && (record.index < header[0]);
+            freeRecords++;
+        }
+        else if ((record.archetype >= 0) && (record.archetype < header[3]) && (record.index >= 0) && (record.index < archetypes[record.archetype].count))
+        {
+            const EcsArchetype &archetype = archetypes[record.archetype];
+            Entity entity = ((const Entity *)GetChunk(archetype, record.index))[record.index%archetype.capacity];
+
+            valid = (entity.slot == slot) && (entity.generation == record.generation);
+            aliveRecords++;
+        }
+        else valid = false;
+    }
+
+    for (int a = 0; valid && (a < header[3]); a++) entityCount += archetypes[a].count;
+    valid = valid && (aliveRecords == entityCount);
+
+    int freeSteps = 0;
+    for (int slot = header[1]; valid && (slot != -1); slot = records[slot].index) valid = (records[slot].archetype == -1) && (++freeSteps <= freeRecords);
+
+    if (!valid)
+    {
+        Clear();
+        return false;
+    }
+
+    freeSlot = header[1];
+    droppedCreates = header[2];
+
+    return true;
+}
+
+// Archetype with exactly these components, created on first use
+inline int EcsWorld::FindArchetype(const int *ids, const int *sizes, int count)
+{
+    ComponentMask mask = 0;
+    for (int i = 0; i < count; i++) mask |= ComponentMask(1) << ids[i];
+
+    for (int a = 0; a < (int)archetypes.size(); a++)
+    {
+        if (archetypes[a].mask == mask) return a;
+    }
+
+    archetypes.emplace_back();
+    EcsArchetype &archetype = archetypes.back();
+    archetype.mask = mask;
+    archetype.count = 0;
+    archetype.componentCount = 0;
+
+    int entityBytes = (int)sizeof(Entity);
+    for (int id = 0; id < ECS_MAX_COMPONENTS; id++)
+    {
+        archetype.offsets[id] = -1;
+        archetype.sizes[id] = 0;
+
+        for (int i = 0; i < count; i++)
+        {
+            if (ids[i] != id) continue;
+
+            archetype.components[archetype.componentCount++] = id;
+            archetype.sizes[id] = sizes[i];
+            entityBytes += sizes[i];
+        }
+    }
+
+    // Leave room for aligning every array, keep capacity a multiple of 8
+    int capacity = (ECS_CHUNK_SIZE - (archetype.componentCount + 1)*ARENA_ALIGNMENT)/entityBytes;
+    if (capacity > ECS_MAX_CHUNK_ENTITIES) capacity = ECS_MAX_CHUNK_ENTITIES;
+    archetype.capacity = capacity & ~7;
+
+    int offset = (int)sizeof(Entity)*archetype.capacity;
+    for (int i = 0; i < archetype.componentCount; i++)
+    {
+        int id = archetype.components[i];
+
+        offset = (offset + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+        archetype.offsets[id] = offset;
+        offset += archetype.sizes[id]*archetype.capacity;
+    }
+
+    return (int)archetypes.size() - 1;
+}
+
+// Reserve archetype index and entity slot, slots are reused last released first
+inline int EcsWorld::AddEntity(int archetypeIndex, int *index)
+{
+    EcsArchetype &archetype = archetypes[archetypeIndex];
+
+    if (archetype.count == (int)archetype.chunks.size()*archetype.capacity)
+    {
+        unsigned char *chunk = NULL;
+
+        if (!freeChunks.empty())
+        {
+            chunk = freeChunks.back();
+            freeChunks.pop_back();
+        }
+        else chunk = (unsigned char *)ArenaAlloc(&arena, ECS_CHUNK_SIZE);
+
+        if (chunk == NULL) return -1;
+        archetype.chunks.push_back(chunk);
+    }
+
+    int slot = freeSlot;
+    if (slot != -1) freeSlot = records[slot].index;
+    else
+    {
+        slot = (int)records.size();
+        records.push_back({ -1, 0, 0, false });
+    }
+
+    *index = archetype.count++;
+    records[slot].archetype = archetypeIndex;
+    records[slot].index = *index;
+
+    return slot;
+}
+
+inline void EcsWorld::MoveEntity(EcsArchetype &archetype, int from, int to)
+{
+    unsigned char *source = GetChunk(archetype, from);
+    unsigned char *dest = GetChunk(archetype, to);
+    int s = from%archetype.capacity;
+    int d = to%archetype.capacity;
+
+    Entity entity = ((Entity *)source)[s];
+    ((Entity *)dest)[d] = entity;
+    records[entity.slot].index = to;
+
+    for (int i = 0; i < archetype.componentCount; i++)
+    {
+        int id = archetype.components[i];
+        int size = archetype.sizes[id];
+
+        memcpy(dest + archetype.offsets[id] + d*size, source + archetype.offsets[id] + s*size, size);
+    }
+}
+
+// Entities from this chunk on rounded up to a power of two, capacity for full chunks
+inline int EcsWorld::GetSavedCount(const EcsArchetype &archetype, int remaining)
+{
+    int saved = 1;
+    while ((saved < remaining) && (saved < archetype.capacity)) saved *= 2;
+
+    return (saved < archetype.capacity)? saved : archetype.capacity;
+}
+
+inline void EcsWorld::Clear()
+{
+    for (EcsArchetype &archetype : archetypes)
+    {
+        freeChunks.insert(freeChunks.end(), archetype.chunks.begin(), archetype.chunks.end());
+        archetype.chunks.clear();
+        archetype.count = 0;
+    }
+
+    records.clear();
+    pendingSlots.clear();
+    freeSlot = -1;
+}
+
+#endif // ECS_HPP
@@ -0,0 +1,224 @@
+/**********************************************************************************************
+*
+*   Frame Pacer - Low jitter frame rate limiter
+*
+*   See frame_pacer.h for an overview.
+*
+*   NOTE: This module must not include raylib.h, windows.h declarations collide with it
+*
+**********************************************************************************************/
+
+#include "frame_pacer.h"
+#include "timing.h"
+
+#include <string.h>             // Required for: memset()
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>        // Required for: CreateWaitableTimerExW(), SetWaitableTimer(), WaitForSingleObject()
+
+    #if !defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+        #define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION   0x00000002  // Windows 10 1803, missing from older SDKs
+    #endif
+#else
+    #include <time.h>           // Required for: nanosleep()
+#endif
+
+#define FRAME_PACER_INITIAL_MARGIN  1000000LL   // Nanoseconds, until sleeps were measured
+#define FRAME_PACER_MIN_MARGIN      50000LL     // Nanoseconds, covers the timer read after waking
+#define FRAME_PACER_SLEEP_SLICE     2000000ULL  // Nanoseconds, longest single sleep
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static const int bucketLimits[FRAME_PACER_BUCKETS] = { 25, 50, 100, 250, 500, 1000, 2000, 4000, -1 };
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned long long WaitUntil(FramePacer *pacer, unsigned long long now, unsigned long long target);   // Returns time waited until
+static void SleepPacer(FramePacer *pacer, unsigned long long duration);    // Nanoseconds, may wake late
+static void CalibrateSleep(FramePacer *pacer, long long error);            // Margin from how late last sleep woke
+static void RecordInterval(FramePacer *pacer, unsigned long long interval);
+
+//----------------------------------------------------------------------------------
+// Frame Pacer Functions Definition
+//----------------------------------------------------------------------------------
+FramePacer LoadFramePacer(int rate)
+{
+    FramePacer pacer = { 0 };
+
+    pacer.sleepDeviation = FRAME_PACER_INITIAL_MARGIN/4;
+    pacer.sleepPeak = FRAME_PACER_INITIAL_MARGIN;
+    pacer.margin = FRAME_PACER_INITIAL_MARGIN;
+
+#if defined(_WIN32)
+    // Plain waitable timers follow the scheduler tick (15.6 ms by default), too coarse to pace frames
+    pacer.timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (pacer.timer == NULL) pacer.timer = CreateWaitableTimerW(NULL, TRUE, NULL);
+#endif
+
+    SetFramePacerRate(&pacer, rate);
+
+    return pacer;
+}
+
+void UnloadFramePacer(FramePacer *pacer)
+{
+#if defined(_WIN32)
+    if (pacer->timer != NULL) CloseHandle((HANDLE)pacer->timer);
+#endif
+    pacer->timer = NULL;
+}
+
+void SetFramePacerRate(FramePacer *pacer, int rate)
+{
+    pacer->period = (rate > 0)? 1000000000ULL/rate : 0;
+    pacer->deadline = 0;
+    pacer->lastInterval = 0;
+}
+
+// Frame starts with a delay from now, the deadline wins when it is later
+void SetFramePacerDelay(FramePacer *pacer, int microseconds)
+{
+    pacer->delay = (microseconds > 0)? (unsigned long long)microseconds*1000ULL : 0;
+}
+
+// Wait for deadline and delay, then set next deadline
+unsigned long long WaitFramePacer(FramePacer *pacer)
+{
+    unsigned long long now = GetTimestampNs();
+    unsigned long long target = now + pacer->delay;
+
+    if ((pacer->period > 0) && (pacer->deadline > target)) target = pacer->deadline;
+    if (target > now) now = WaitUntil(pacer, now, target);
+
+    if (pacer->frameStart != 0) RecordInterval(pacer, now - pacer->frameStart);
+    pacer->frameStart = now;
+
+    if (pacer->period > 0)
+    {
+        if (pacer->deadline == 0) pacer->deadline = now + pacer->period;
+        else
+        {
+            pacer->deadline += pacer->period;
+
+            // A period behind already, start over from now instead of rushing frames to catch up
+            if (pacer->deadline <= now)
+            {
+                pacer->deadline = now + pacer->period;
+                pacer->missed++;
+            }
+        }
+    }
+
+    return now;
+}
+
+void ResetFramePacerStats(FramePacer *pacer)
+{
+    memset(pacer->histogram, 0, sizeof(pacer->histogram));
+    pacer->frames = 0;
+    pacer->missed = 0;
+    pacer->maxError = 0;
+    pacer->sleptNs = 0;
+    pacer->spunNs = 0;
+}
+
+int GetFramePacerBucketLimit(int bucket)
+{
+    if ((bucket < 0) || (bucket >= FRAME_PACER_BUCKETS)) return -1;
+
+    return bucketLimits[bucket];
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Sleep until margin before target by slices, spin the rest
+// NOTE: The spin does not yield, the scheduler may not give the thread back before target
+static unsigned long long WaitUntil(FramePacer *pacer, unsigned long long now, unsigned long long target)
+{
+    while ((long long)(target - now) > pacer->margin)
+    {
+        unsigned long long wake = target - pacer->margin;
+
+        if (wake - now > FRAME_PACER_SLEEP_SLICE) wake = now + FRAME_PACER_SLEEP_SLICE;
+
+        SleepPacer(pacer, wake - now);
+
+        unsigned long long woke = GetTimestampNs();
+        CalibrateSleep(pacer, (long long)(woke - wake));
+        pacer->sleptNs += woke - now;
+        now = woke;
+    }
+
+    unsigned long long spinStart = now;
+
+    while (now < target) now = GetTimestampNs();
+
+    pacer->spunNs += now - spinStart;
+
+    return now;
+}
+
+static void SleepPacer(FramePacer *pacer, unsigned long long duration)
+{
+#if defined(_WIN32)
+    if (pacer->timer != NULL)
+    {
+        LARGE_INTEGER due = { 0 };
+        due.QuadPart = -(LONGLONG)(duration/100);   // Relative, in 100 ns units
+
+        if (SetWaitableTimer((HANDLE)pacer->timer, &due, 0, NULL, NULL, FALSE))
+        {
+            WaitForSingleObject((HANDLE)pacer->timer, INFINITE);
+            return;
+        }
+    }
+
+    Sleep((DWORD)(duration/1000000ULL));
+#else
+    (void)pacer;
+
+    struct timespec span = { (time_t)(duration/1000000000ULL), (long)(duration%1000000000ULL) };
+    nanosleep(&span, NULL);
+#endif
+}
+
+// Running mean and mean deviation of the sleep error, weighted 1/8 and 1/4 like RTT estimators,
+// and the worst error, decaying by 1/256 per sleep: a single late wake widens the margin at once,
+// it shrinks back over a few seconds
+static void CalibrateSleep(FramePacer *pacer, long long error)
+{
+    if (error < 0) error = 0;
+
+    long long difference = error - pacer->sleepError;
+
+    pacer->sleepError += difference/8;
+    pacer->sleepDeviation += (((difference < 0)? -difference : difference) - pacer->sleepDeviation)/4;
+    pacer->sleepPeak = (error > pacer->sleepPeak)? error : pacer->sleepPeak - pacer->sleepPeak/256;
+    pacer->margin = pacer->sleepError + 4*pacer->sleepDeviation;
+    if (pacer->margin < pacer->sleepPeak) pacer->margin = pacer->sleepPeak;
+
+    if (pacer->margin < FRAME_PACER_MIN_MARGIN) pacer->margin = FRAME_PACER_MIN_MARGIN;
+    if ((pacer->period > 0) && (pacer->margin > (long long)pacer->period)) pacer->margin = (long long)pacer->period;
+}
+
+// Error against the target period, or against the previous interval when uncapped
+static void RecordInterval(FramePacer *pacer, unsigned long long interval)
+{
+    unsigned long long expected = (pacer->period > 0)? pacer->period : pacer->lastInterval;
+
+    pacer->lastInterval = interval;
+    if (expected == 0) return;
+
+    unsigned long long error = (interval > expected)? interval - expected : expected - interval;
+    int bucket = 0;
+
+    while ((bucketLimits[bucket] != -1) && (error > (unsigned long long)bucketLimits[bucket]*1000ULL)) bucket++;
+
+    pacer->histogram[bucket]++;
+    pacer->frames++;
+    if (error > pacer->maxError) pacer->maxError = error;
+}
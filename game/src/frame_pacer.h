@@ -0,0 +1,76 @@
+/**********************************************************************************************
+*
+*   Frame Pacer - Low jitter frame rate limiter
+*
+*   Holds frames to a target rate (60, 120, 144... or uncapped) without relying on vsync or
+*   on a coarse sleep: the wait for the next frame deadline sleeps on a high resolution timer
+*   until a margin before it, then spins the rest. The margin is calibrated while running
+*   from how late sleeps wake up, so on a precise scheduler almost the whole wait is slept
+*   (lower CPU use, battery powered handhelds) and on a coarse one frames are still on time.
+*
+*   Sleeps are sliced, a slice waking late only shortens the next one, and the margin covers
+*   the worst recent late wake, not only the usual one: a rare late wake of a long sleep
+*   would otherwise land past the deadline, a frame worse than with a plain sleep.
+*
+*   Frames falling more than a whole period behind are not caught up: the next deadline is
+*   set from now, a hitch costs one late frame instead of a burst of short ones.
+*
+*   Every frame interval is recorded: its error against the target period (against the
+*   previous interval when uncapped) goes into a jitter histogram, along with the time
+*   slept and spun. With rate 0 the pacer only measures, for vsync or uncapped frames.
+*
+*   A delay can also hold every frame start for a while after the previous frame ended:
+*   with vsync, input sampled at frame start is then closer to the next buffer swap.
+*
+*   NOTE: Window independent (only timing.h and the OS timers), shooter_bench uses it too
+*
+**********************************************************************************************/
+
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#define FRAME_PACER_BUCKETS     9       // Jitter histogram buckets, see GetFramePacerBucketLimit()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct FramePacer {
+    unsigned long long period;          // Nanoseconds per frame, 0 uncapped
+    unsigned long long deadline;        // Next frame start
+    unsigned long long delay;           // Nanoseconds from WaitFramePacer() call to frame start, at least
+    unsigned long long frameStart;      // Last frame start, returned by WaitFramePacer()
+    unsigned long long lastInterval;
+    long long margin;                   // Spun before deadline, sleep error peak or mean + 4 deviations
+    long long sleepError;               // How late sleeps wake up, running mean
+    long long sleepDeviation;           // Running mean deviation of the above
+    long long sleepPeak;                // Latest worst sleep error, decays slowly
+    void *timer;                        // High resolution waitable timer (Windows), NULL elsewhere
+
+    int histogram[FRAME_PACER_BUCKETS]; // Frames per interval error bucket
+    int frames;                         // Intervals recorded
+    int missed;                         // Frames over a period late, deadline was reset
+    unsigned long long maxError;        // Largest interval error, nanoseconds
+    unsigned long long sleptNs;
+    unsigned long long spunNs;
+} FramePacer;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Frame Pacer Functions Declaration
+//----------------------------------------------------------------------------------
+FramePacer LoadFramePacer(int rate);                    // Frames per second, 0 to only measure
+void UnloadFramePacer(FramePacer *pacer);
+void SetFramePacerRate(FramePacer *pacer, int rate);    // Deadlines restart from next frame, stats are kept
+void SetFramePacerDelay(FramePacer *pacer, int microseconds);   // Frame start delay, 0 by default
+unsigned long long WaitFramePacer(FramePacer *pacer);   // Call once at frame start, returns frame start timestamp
+void ResetFramePacerStats(FramePacer *pacer);
+int GetFramePacerBucketLimit(int bucket);               // Microseconds, upper bound of bucket error, -1 for the last one
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_PACER_H
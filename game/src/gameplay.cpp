@@ -0,0 +1,876 @@
+/**********************************************************************************************
+*
+*   Gameplay - Simulation, independent of window and input devices
+*
+*   See gameplay.h for an overview.
+*
+*   Player, emitters and bullets are entities of an EcsWorld (ecs.hpp). Bullet fields are
+*   single float components, so the arrays of a bullet chunk are the arrays MoveBullets()
+*   works on, and a whole emitter volley is written into them by WriteVolleyBullets().
+*
+*   Analytic bullets are another archetype: origin and spawn tick instead of a position that
+*   is stepped, no alive scan. Expiries are a min-heap of (exit tick, entity), entries of
+*   bullets that were hit before leaving are skipped when they come out, their entity is gone.
+*
+*   NOTE: Nothing in this module may query the window, input devices or audio, it must run
+*   without InitWindow() having been called
+*
+**********************************************************************************************/
+
+#include "gameplay.h"
+#include "collision.h"
+#include "ecs.hpp"
+#include "jobs.h"           // Required for: ParallelFor()
+#include "profiler.h"
+#include "raymath.h"
+#include "threads.h"        // Required for: AtomicAdd()
+
+#include <algorithm>        // Required for: std::sort(), std::upper_bound(), std::push_heap(), std::pop_heap()
+#include <limits.h>         // Required for: INT_MAX
+#include <math.h>           // Required for: sqrtf()
+#include <stddef.h>         // Required for: offsetof()
+#include <stdlib.h>         // Required for: realloc(), free()
+#include <string.h>         // Required for: memcpy(), memset(), memcmp()
+#include <type_traits>      // Required for: std::is_trivially_copyable
+
+#define BULLET_RADIUS           4.0f
+#define COLLISION_CELL_SIZE     32.0f
+#define MAX_PLAYERS_FIRING      4       // Shots per tick, one per player
+
+static_assert(ECS_MAX_CHUNK_ENTITIES <= BULLETS_PER_CHUNK, "Bullet render buffers hold BULLETS_PER_CHUNK bullets");
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Player components
+struct Position { Vector2 value; };
+struct PreviousPosition { Vector2 value; };     // Position on previous tick, for interpolation
+struct PlayerControl {
+    float size;
+    float speed;
+    float projectileSpeed;
+};
+
+// Bullet components, one float each so chunk arrays are plain float arrays
+struct BulletX { float value; };
+struct BulletY { float value; };
+struct BulletDirectionX { float value; };       // Normalized at spawn
+struct BulletDirectionY { float value; };
+struct BulletSpeed { float value; };
+struct BulletAlive { unsigned char value; };    // 0 once out of field or hit, until destroyed
+
+// Analytic bullet components, along with direction, speed and alive flag
+struct BulletOriginX { float value; };
+struct BulletOriginY { float value; };
+struct BulletSpawnTick { int value; };          // Tick the bullet was fired on, at origin
+
+// Tick an analytic bullet leaves the field, min-heap entry
+struct BulletExpiry {
+    int tick;
+    Entity bullet;
+};
+
+static_assert((sizeof(BulletX) == sizeof(float)) && (sizeof(BulletOriginX) == sizeof(float)) &&
+              (sizeof(BulletSpawnTick) == sizeof(int)) && (sizeof(BulletAlive) == 1), "Bullet components must be plain arrays");
+
+// Emitter components, along with Position
+struct Emitter {
+    int pattern;
+    int tick;               // Ticks since emitter was added
+    int volley;             // Volleys fired
+};
+
+// Volley due on this tick, spawned once emitters are iterated
+struct PendingVolley {
+    int pattern;
+    int volley;
+    Vector2 origin;
+};
+
+// Simulation values, plain data so saving a tick is one copy
+// NOTE: Targets are stored by field for the collision queries
+struct GameplayState {
+    Rectangle field;
+    int tick;
+    float tickTime;                             // Last dt given, exit ticks are computed with it
+    Entity player;
+    int spawnCount;
+    ProjectileMode projectileMode;
+    int targetCount;
+    Vector2 targetCenters[MAX_TARGETS];
+    Vector2 targetHalfSizes[MAX_TARGETS];       // Zero for circle targets
+    float targetRadii[MAX_TARGETS];             // Zero for box targets
+    int targetHits[MAX_TARGETS];
+};
+
+static_assert(std::is_trivially_copyable<GameplayState>::value && (sizeof(ProjectileMode) == sizeof(int)), "Gameplay state is saved with memcpy()");
+
+// MoveBullets() over bullet chunks, one job range is a range of chunks
+struct MoveBulletChunksJob {
+    const EcsChunkView *views;
+    float dt;
+    Rectangle bounds;
+    volatile int despawned;
+};
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+// Every value of the simulation but entities and the expiry heap, in one block a snapshot copies as is
+static GameplayState state = { Rectangle{ 0.0f, 0.0f, 0.0f, 0.0f }, 0, 1.0f/60.0f, INVALID_ENTITY, 0, PROJECTILE_ANALYTIC, 0, {}, {}, {}, {} };
+static EcsWorld world;
+static std::vector<BulletExpiry> bulletExpiries;    // Min-heap on tick, analytic bullets only
+
+// Derived from the above or only used during a tick, not part of snapshots
+static std::vector<EcsChunkView> bulletChunks;  // Bullet chunks as of last flush, for rendering and checksum
+static const BulletPatterns *patterns = NULL;
+static std::vector<PendingVolley> pendingVolleys;
+static BulletGrid bulletGrid = {};
+static std::vector<GameEvent> tickEvents;       // Shots and hits of last tick
+
+// Collision scratch, grown on demand and kept between ticks
+static float *collisionX = NULL;                // Bullet positions at start of tick, gathered from chunks
+static float *collisionY = NULL;
+static float *collisionMotionX = NULL;          // Bullet motion during the tick
+static float *collisionMotionY = NULL;
+static int collisionCapacity = 0;
+static CollisionHit *collisionHits = NULL;
+static int collisionHitsCapacity = 0;
+static size_t bulletBudget = BULLETS_DEFAULT_BUDGET;
+static ProjectileMode nextProjectileMode = PROJECTILE_ANALYTIC;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void UpdatePlayers(GameInput input, float dt);
+static void UpdateEmitters(void);
+static void EmitVolley(const BulletPattern *pattern, int volley, Vector2 origin, Vector2 target);
+static void UpdateBullets(float dt);
+static int ExpireBullets(int tick);                 // Returns bullets destroyed
+static void QueryBullets(std::vector<EcsChunkView> &views);
+static void MoveBulletChunksRange(void *data, int start, int end);
+static void GatherBulletMotions(int count);
+static const EcsChunkView &GetBulletChunk(int index);   // Chunk holding bullet at query position
+static void Fire(Vector2 origin, float speed, Vector2 target);
+static void PushBulletExpiry(Entity bullet, Vector2 origin, Vector2 direction, float speed);
+static bool IsLaterExpiry(const BulletExpiry &a, const BulletExpiry &b);
+static unsigned int HashBytes(unsigned int hash, const void *data, size_t size);
+
+//----------------------------------------------------------------------------------
+// Gameplay Functions Definition
+//----------------------------------------------------------------------------------
+
+// Reset simulation on given play field
+void InitGameplay(Rectangle playField)
+{
+    state.field = playField;
+    state.tick = 0;
+    state.targetCount = 0;
+    state.spawnCount = 0;
+    state.projectileMode = nextProjectileMode;
+
+    world.Init(bulletBudget);
+    bulletChunks.clear();
+    bulletExpiries.clear();
+    tickEvents.clear();
+
+    PlayerControl control = { 24.0f, 150.0f, 300.0f };
+    Position position = { { state.field.x + state.field.width/2, state.field.y + state.field.height - (int)control.size/2 } };
+    state.player = world.Create(position, PreviousPosition{ position.value }, control);
+
+    UnloadBulletGrid(&bulletGrid);
+    InitBulletGrid(&bulletGrid, state.field, COLLISION_CELL_SIZE, BULLETS_PER_CHUNK);
+}
+
+void UnloadGameplay(void)
+{
+    world.Unload();
+    std::vector<EcsChunkView>().swap(bulletChunks);
+    std::vector<PendingVolley>().swap(pendingVolleys);
+    std::vector<BulletExpiry>().swap(bulletExpiries);
+    std::vector<GameEvent>().swap(tickEvents);
+    state.player = INVALID_ENTITY;
+    UnloadBulletGrid(&bulletGrid);
+
+    free(collisionX);
+    free(collisionY);
+    free(collisionMotionX);
+    free(collisionMotionY);
+    free(collisionHits);
+    collisionX = NULL;
+    collisionY = NULL;
+    collisionMotionX = NULL;
+    collisionMotionY = NULL;
+    collisionHits = NULL;
+    collisionCapacity = 0;
+    collisionHitsCapacity = 0;
+}
+
+// Bytes entities may use, applied on next InitGameplay()
+void SetGameplayBulletBudget(size_t budget)
+{
+    bulletBudget = budget;
+}
+
+void SetGameplayProjectileMode(ProjectileMode mode)
+{
+    nextProjectileMode = mode;
+}
+
+// Pattern tables emitters refer to, kept by caller while emitters exist
+void SetGameplayPatterns(const BulletPatterns *bulletPatterns)
+{
+    patterns = bulletPatterns;
+}
+
+// Emitter starts firing on next tick, volleys are aimed at the player
+bool AddGameplayEmitter(int pattern, Vector2 position)
+{
+    if ((patterns == NULL) || (pattern < 0) || (pattern >= patterns->patternCount)) return false;
+
+    Entity emitter = world.Create(Position{ position }, Emitter{ pattern, 0, 0 });
+
+    return (emitter.slot != INVALID_ENTITY.slot);
+}
+
+// Emitters of the patterns file, placed as fractions of the play field
+// NOTE: Game and replays both set up emitters this way, so recorded checksums match
+int AddGameplayPatternEmitters(const BulletPatterns *bulletPatterns)
+{
+    int added = 0;
+
+    SetGameplayPatterns(bulletPatterns);
+
+    for (int i = 0; i < bulletPatterns->emitterCount; i++)
+    {
+        const PatternEmitter *emitter = &bulletPatterns->emitters[i];
+        Vector2 position = { state.field.x + emitter->position.x*state.field.width, state.field.y + emitter->position.y*state.field.height };
+
+        if (AddGameplayEmitter(emitter->pattern, position)) added++;
+    }
+
+    return added;
+}
+
+int GetGameplayEmitterCount(void)
+{
+    return world.Count<Emitter>();
+}
+
+// Simulate one tick
+void UpdateGameplay(GameInput input, float dt)
+{
+    state.tickTime = dt;
+    tickEvents.clear();
+    UpdatePlayers(input, dt);
+    UpdateEmitters();
+    UpdateBullets(dt);
+    state.tick++;
+}
+
+Vector2 GetPlayerPosition(float alpha)
+{
+    const Position *position = world.Get<Position>(state.player);
+    const PreviousPosition *previous = world.Get<PreviousPosition>(state.player);
+
+    if (position == NULL) return Vector2{ 0.0f, 0.0f };
+    return Vector2Lerp(previous->value, position->value, alpha);
+}
+
+float GetPlayerSize(void)
+{
+    const PlayerControl *control = world.Get<PlayerControl>(state.player);
+
+    return (control != NULL)? control->size : 0.0f;
+}
+
+// Bullet chunks are listed again after every tick, last one ends at the bullet count
+int GetGameplayBulletCount(void)
+{
+    if (bulletChunks.empty()) return 0;
+    return bulletChunks.back().first + bulletChunks.back().count;
+}
+
+int GetGameplaySpawnCount(void)
+{
+    return state.spawnCount;
+}
+
+// Every entity create counts, only bullets are spawned once the game runs
+int GetGameplayDroppedSpawns(void)
+{
+    return world.GetDroppedCreates();
+}
+
+int GetGameplayBulletChunkCount(void)
+{
+    return (int)bulletChunks.size();
+}
+
+// Interpolate between last two ticks of dt seconds, motion is linear so the previous
+// position is recomputed from direction and speed instead of being stored
+int GetGameplayBulletRenderPositions(int chunk, float alpha, float dt, float *renderX, float *renderY)
+{
+    if ((chunk < 0) || (chunk >= (int)bulletChunks.size())) return 0;
+
+    const EcsChunkView &view = bulletChunks[chunk];
+
+    if (state.projectileMode == PROJECTILE_ANALYTIC)
+    {
+        GetBulletPositionsAt(&view.Get<BulletOriginX>()->value, &view.Get<BulletOriginY>()->value,
+                             &view.Get<BulletDirectionX>()->value, &view.Get<BulletDirectionY>()->value, &view.Get<BulletSpeed>()->value,
+                             &view.Get<BulletSpawnTick>()->value, view.count, state.tick, alpha - 1.0f, dt, renderX, renderY);
+
+        return view.count;
+    }
+
+    const float *positionX = &view.Get<BulletX>()->value;
+    const float *positionY = &view.Get<BulletY>()->value;
+    const float *directionX = &view.Get<BulletDirectionX>()->value;
+    const float *directionY = &view.Get<BulletDirectionY>()->value;
+    const float *speed = &view.Get<BulletSpeed>()->value;
+    float back = (1.0f - alpha)*dt;
+
+    for (int i = 0; i < view.count; i++)
+    {
+        float step = speed[i]*back;
+        renderX[i] = positionX[i] - directionX[i]*step;
+        renderY[i] = positionY[i] - directionY[i]*step;
+    }
+
+    return view.count;
+}
+
+int AddGameplayTarget(Vector2 center, float radius)
+{
+    if (state.targetCount >= MAX_TARGETS) return -1;
+
+    state.targetCenters[state.targetCount] = center;
+    state.targetHalfSizes[state.targetCount] = Vector2{ 0.0f, 0.0f };
+    state.targetRadii[state.targetCount] = radius;
+    state.targetHits[state.targetCount] = 0;
+
+    return state.targetCount++;
+}
+
+// Walls can be thinner than a bullet moves in a tick, collisions are swept
+int AddGameplayBoxTarget(Rectangle box)
+{
+    if (state.targetCount >= MAX_TARGETS) return -1;
+
+    state.targetCenters[state.targetCount] = Vector2{ box.x + box.width/2, box.y + box.height/2 };
+    state.targetHalfSizes[state.targetCount] = Vector2{ box.width/2, box.height/2 };
+    state.targetRadii[state.targetCount] = 0.0f;
+    state.targetHits[state.targetCount] = 0;
+
+    return state.targetCount++;
+}
+
+int GetGameplayTargetCount(void)
+{
+    return state.targetCount;
+}
+
+GameTarget GetGameplayTarget(int index)
+{
+    GameTarget target = { state.targetCenters[index], state.targetHalfSizes[index], state.targetRadii[index], state.targetHits[index] };
+    return target;
+}
+
+int GetGameplayTick(void)
+{
+    return state.tick;
+}
+
+// Heap memory held by the simulation, entity storage is counted as reserved not used
+size_t GetGameplayMemory(void)
+{
+    size_t gridCells = (size_t)bulletGrid.columns*bulletGrid.rows;
+    size_t memory = world.GetMemory();
+
+    memory += bulletChunks.capacity()*sizeof(EcsChunkView);
+    memory += pendingVolleys.capacity()*sizeof(PendingVolley);
+    memory += bulletExpiries.capacity()*sizeof(BulletExpiry);
+    memory += tickEvents.capacity()*sizeof(GameEvent);
+    memory += (2*gridCells + 1 + 2*(size_t)bulletGrid.capacity)*sizeof(int);
+    memory += 4*(size_t)collisionCapacity*sizeof(float);
+    memory += (size_t)collisionHitsCapacity*sizeof(CollisionHit);
+
+    return memory;
+}
+
+// Hash of everything a tick changes, O(bullets)
+// NOTE: Bullets are hashed in query order, it is deterministic as long as the simulation is
+unsigned int GetGameplayChecksum(void)
+{
+    unsigned int hash = 2166136261u;    // FNV-1a offset basis
+    Vector2 playerPosition = GetPlayerPosition(1.0f);
+    int bulletCount = GetGameplayBulletCount();
+
+    hash = HashBytes(hash, &state.tick, sizeof(state.tick));
+    hash = HashBytes(hash, &playerPosition, sizeof(playerPosition));
+    hash = HashBytes(hash, &bulletCount, sizeof(bulletCount));
+
+    for (const EcsChunkView &view : bulletChunks)
+    {
+        if (state.projectileMode == PROJECTILE_ANALYTIC)
+        {
+            hash = HashBytes(hash, view.Get<BulletOriginX>(), view.count*sizeof(BulletOriginX));
+            hash = HashBytes(hash, view.Get<BulletOriginY>(), view.count*sizeof(BulletOriginY));
+            hash = HashBytes(hash, view.Get<BulletSpawnTick>(), view.count*sizeof(BulletSpawnTick));
+        }
+        else
+        {
+            hash = HashBytes(hash, view.Get<BulletX>(), view.count*sizeof(BulletX));
+            hash = HashBytes(hash, view.Get<BulletY>(), view.count*sizeof(BulletY));
+        }
+
+        hash = HashBytes(hash, view.GetEntities(), view.count*sizeof(Entity));
+    }
+
+    hash = HashBytes(hash, state.targetHits, state.targetCount*sizeof(int));
+
+    world.ForEachChunk<Emitter>([&hash](int count, Emitter *emitters)
+    {
+        hash = HashBytes(hash, emitters, count*sizeof(Emitter));
+    });
+
+    return hash;
+}
+
+// Snapshot layout: state block, world size and world, expiry count and expiries
+int GetGameplayStateSize(void)
+{
+    return (int)(sizeof(GameplayState) + 2*sizeof(int) + world.GetStateSize() + bulletExpiries.size()*sizeof(BulletExpiry));
+}
+
+int SaveGameplayState(void *data, int capacity)
+{
+    int size = GetGameplayStateSize();
+    if (size > capacity) return 0;
+
+    unsigned char *bytes = (unsigned char *)data;
+    int worldSize = (int)world.GetStateSize();
+    int expiryCount = (int)bulletExpiries.size();
+
+    memcpy(bytes, &state, sizeof(GameplayState));
+    bytes += sizeof(GameplayState);
+    memcpy(bytes, &worldSize, sizeof(int));
+    bytes += sizeof(int) + world.SaveState(bytes + sizeof(int));
+    memcpy(bytes, &expiryCount, sizeof(int));
+    if (expiryCount > 0) memcpy(bytes + sizeof(int), bulletExpiries.data(), expiryCount*sizeof(BulletExpiry));
+
+    return size;
+}
+
+// Patterns and budget are not saved, they must be the ones the state was saved with
+// NOTE: On failure the simulation is reset, as after InitGameplay()
+bool LoadGameplayState(const void *data, int size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    int headerSize = (int)(sizeof(GameplayState) + sizeof(int));
+    int worldSize = 0;
+    int expiryCount = 0;
+
+    if (size < headerSize + (int)sizeof(int)) return false;
+
+    memcpy(&worldSize, bytes + sizeof(GameplayState), sizeof(int));
+    if ((worldSize < 0) || (worldSize > size - headerSize - (int)sizeof(int))) return false;
+
+    memcpy(&expiryCount, bytes + headerSize + worldSize, sizeof(int));
+    if ((expiryCount < 0) || ((size_t)expiryCount*sizeof(BulletExpiry) != (size_t)(size - headerSize - worldSize - sizeof(int)))) return false;
+
+    // Field is checked too, collision grid was built for it
+    GameplayState saved = {};
+    int mode = 0;
+
+    memcpy(&mode, bytes + offsetof(GameplayState, projectileMode), sizeof(int));
+    if ((mode != PROJECTILE_ANALYTIC) && (mode != PROJECTILE_INTEGRATED)) return false;
+
+    memcpy(&saved, bytes, sizeof(GameplayState));
+    if ((saved.targetCount < 0) || (saved.targetCount > MAX_TARGETS) || (memcmp(&saved.field, &state.field, sizeof(Rectangle)) != 0)) return false;
+
+    bool valid = world.LoadState(bytes + headerSize, worldSize);
+
+    // Emitters index the pattern tables
+    world.ForEach<Emitter>([&valid](Emitter &emitter)
+    {
+        if ((patterns == NULL) || (emitter.pattern < 0) || (emitter.pattern >= patterns->patternCount)) valid = false;
+    });
+
+    if (!valid)
+    {
+        InitGameplay(state.field);
+        return false;
+    }
+
+    state = saved;
+    bulletExpiries.resize(expiryCount);
+    if (expiryCount > 0) memcpy(bulletExpiries.data(), bytes + headerSize + worldSize + sizeof(int), expiryCount*sizeof(BulletExpiry));
+    QueryBullets(bulletChunks);
+    tickEvents.clear();
+
+    return true;
+}
+
+// Events are only kept until next tick, they are not part of the state
+int GetGameplayEvents(const GameEvent **events)
+{
+    *events = tickEvents.data();
+    return (int)tickEvents.size();
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Move players and fire, every player follows the same input
+static void UpdatePlayers(GameInput input, float dt)
+{
+    // NOTE: Bullets are created after the query, creating entities while iterating may move chunks
+    Vector2 origins[MAX_PLAYERS_FIRING] = {};
+    float speeds[MAX_PLAYERS_FIRING] = { 0 };
+    int fireCount = 0;
+
+    world.ForEach<Position, PreviousPosition, PlayerControl>([&](Position &position, PreviousPosition &previous, PlayerControl &control)
+    {
+        previous.value = position.value;
+
+        if (input.moveLeft)
+        {
+            float newX = position.value.x - control.speed*dt;
+            if (newX >= state.field.x + (int)control.size/2) position.value.x = newX;
+        }
+
+        if (input.moveRight)
+        {
+            float newX = position.value.x + control.speed*dt;
+            if (newX <= state.field.x + state.field.width) position.value.x = newX;
+        }
+
+        if (input.fire && (fireCount < MAX_PLAYERS_FIRING))
+        {
+            origins[fireCount] = position.value;
+            speeds[fireCount] = control.projectileSpeed;
+            fireCount++;
+        }
+    });
+
+    // fire!
+    for (int i = 0; i < fireCount; i++) Fire(origins[i], speeds[i], input.cursor);
+}
+
+// Find emitters due to fire, then spawn their volleys
+// NOTE: Bullets are created after the query, creating entities while iterating may move chunks
+static void UpdateEmitters(void)
+{
+    if (patterns == NULL) return;
+
+    pendingVolleys.clear();
+
+    world.ForEach<Position, Emitter>([](Position &position, Emitter &emitter)
+    {
+        if (IsVolleyTick(&patterns->patterns[emitter.pattern], emitter.tick)) pendingVolleys.push_back({ emitter.pattern, emitter.volley++, position.value });
+        emitter.tick++;
+    });
+
+    Vector2 target = GetPlayerPosition(1.0f);
+
+    for (const PendingVolley &volley : pendingVolleys) EmitVolley(&patterns->patterns[volley.pattern], volley.volley, volley.origin, target);
+}
+
+// Whole volley in one batch, bullets are written straight into chunk arrays
+static void EmitVolley(const BulletPattern *pattern, int volley, Vector2 origin, Vector2 target)
+{
+    Vector2 direction = GetVolleyDirection(pattern, volley, origin, target);
+
+    if (state.projectileMode == PROJECTILE_ANALYTIC)
+    {
+        state.spawnCount += world.CreateBatch<BulletOriginX, BulletOriginY, BulletDirectionX, BulletDirectionY, BulletSpeed, BulletSpawnTick, BulletAlive>(pattern->count,
+            [&](int first, int count, const Entity *entities, BulletOriginX *x, BulletOriginY *y, BulletDirectionX *directionX,
+                BulletDirectionY *directionY, BulletSpeed *speed, BulletSpawnTick *spawnTick, BulletAlive *alive)
+        {
+            WriteVolleyBullets(patterns, pattern, direction, origin, first, count,
+                               &x->value, &y->value, &directionX->value, &directionY->value, &speed->value);
+            memset(alive, 1, count*sizeof(BulletAlive));
+
+            for (int i = 0; i < count; i++)
+            {
+                spawnTick[i].value = state.tick;
+                PushBulletExpiry(entities[i], origin, Vector2{ directionX[i].value, directionY[i].value }, speed[i].value);
+            }
+        });
+    }
+    else
+    {
+        state.spawnCount += world.CreateBatch<BulletX, BulletY, BulletDirectionX, BulletDirectionY, BulletSpeed, BulletAlive>(pattern->count,
+            [&](int first, int count, const Entity *, BulletX *x, BulletY *y, BulletDirectionX *directionX, BulletDirectionY *directionY,
+                BulletSpeed *speed, BulletAlive *alive)
+        {
+            WriteVolleyBullets(patterns, pattern, direction, origin, first, count,
+                               &x->value, &y->value, &directionX->value, &directionY->value, &speed->value);
+            memset(alive, 1, count*sizeof(BulletAlive));
+        });
+    }
+}
+
+static void UpdateBullets(float dt)
+{
+    PROFILE_SCOPE(PROFILE_BULLETS)
+    {
+        QueryBullets(bulletChunks);
+        int bulletCount = GetGameplayBulletCount();
+        int deadCount = 0;
+
+        // check collisions
+        if ((state.targetCount > 0) && (bulletCount > 0))
+        {
+            // Whole segment moved along this tick is tested, fast bullets cannot go through thin targets
+            GatherBulletMotions(bulletCount);
+            BuildSweptBulletGrid(&bulletGrid, collisionX, collisionY, collisionMotionX, collisionMotionY, bulletCount);
+
+            int hitsCount = CollideSweptBulletsTargets(&bulletGrid, collisionX, collisionY, collisionMotionX, collisionMotionY, BULLET_RADIUS,
+                                                       state.targetCenters, state.targetHalfSizes, state.targetRadii, state.targetCount, collisionHits, collisionHitsCapacity);
+
+            // Not enough room for every hit, grow and query again
+            if (hitsCount > collisionHitsCapacity)
+            {
+                collisionHits = (CollisionHit *)realloc(collisionHits, hitsCount*sizeof(CollisionHit));
+                collisionHitsCapacity = hitsCount;
+                CollideSweptBulletsTargets(&bulletGrid, collisionX, collisionY, collisionMotionX, collisionMotionY, BULLET_RADIUS,
+                                           state.targetCenters, state.targetHalfSizes, state.targetRadii, state.targetCount, collisionHits, collisionHitsCapacity);
+            }
+
+            // A bullet touching several targets during the tick only hits the one it reaches first
+            std::sort(collisionHits, collisionHits + hitsCount, [](const CollisionHit &a, const CollisionHit &b)
+            {
+                if (a.time != b.time) return a.time < b.time;
+                return (a.target < b.target) || ((a.target == b.target) && (a.bullet < b.bullet));
+            });
+
+            for (int h = 0; h < hitsCount; h++)
+            {
+                const EcsChunkView &view = GetBulletChunk(collisionHits[h].bullet);
+                int i = collisionHits[h].bullet - view.first;
+                BulletAlive *alive = view.Get<BulletAlive>();
+
+                if (alive[i].value)
+                {
+                    int b = collisionHits[h].bullet;
+                    float time = collisionHits[h].time;
+
+                    alive[i].value = 0;
+                    state.targetHits[collisionHits[h].target]++;
+                    deadCount++;
+                    tickEvents.push_back({ GAME_EVENT_HIT, Vector2{ collisionX[b] + collisionMotionX[b]*time, collisionY[b] + collisionMotionY[b]*time },
+                                           Vector2{ -collisionMotionX[b], -collisionMotionY[b] } });
+
+                    if (state.projectileMode == PROJECTILE_ANALYTIC) world.Destroy(view.GetEntities()[i]);
+                }
+            }
+        }
+
+        // Out of field only after hits: a bullet crossing a target and leaving on the same tick still hits it
+        if (state.projectileMode == PROJECTILE_ANALYTIC)
+        {
+            // Nothing moves, bullets leaving the field on this tick come out of the heap
+            deadCount += ExpireBullets(state.tick + 1);
+        }
+        else if (!bulletChunks.empty())
+        {
+            // move bullets and check out of field, one job per chunk
+            MoveBulletChunksJob job = { bulletChunks.data(), dt, state.field, 0 };
+            ParallelFor((int)bulletChunks.size(), 1, MoveBulletChunksRange, &job);
+            deadCount += job.despawned;
+        }
+
+        // Dead bullets are only flagged while iterating, destroy them now
+        if (deadCount > 0)
+        {
+            // NOTE: Analytic bullets were destroyed by entity as they died, there is nothing to scan
+            if (state.projectileMode == PROJECTILE_INTEGRATED)
+            {
+                for (const EcsChunkView &view : bulletChunks)
+                {
+                    const BulletAlive *alive = view.Get<BulletAlive>();
+                    const Entity *entities = view.GetEntities();
+
+                    for (int i = 0; i < view.count; i++)
+                    {
+                        if (!alive[i].value) world.Destroy(entities[i]);
+                    }
+                }
+            }
+
+            world.FlushDestroyed();
+            QueryBullets(bulletChunks);
+        }
+    }
+}
+
+// Destroy bullets whose exit tick has come
+static int ExpireBullets(int tick)
+{
+    int expired = 0;
+
+    while (!bulletExpiries.empty() && (bulletExpiries.front().tick <= tick))
+    {
+        std::pop_heap(bulletExpiries.begin(), bulletExpiries.end(), IsLaterExpiry);
+        Entity bullet = bulletExpiries.back().bullet;
+        bulletExpiries.pop_back();
+
+        // Already hit, or its slot went to a newer bullet
+        if (!world.IsAlive(bullet)) continue;
+
+        world.Get<BulletAlive>(bullet)->value = 0;
+        world.Destroy(bullet);
+        expired++;
+    }
+
+    return expired;
+}
+
+static void QueryBullets(std::vector<EcsChunkView> &views)
+{
+    if (state.projectileMode == PROJECTILE_ANALYTIC) world.Query<BulletOriginX, BulletOriginY, BulletDirectionX, BulletDirectionY, BulletSpeed, BulletSpawnTick, BulletAlive>(views);
+    else world.Query<BulletX, BulletY, BulletDirectionX, BulletDirectionY, BulletSpeed, BulletAlive>(views);
+}
+
+static void MoveBulletChunksRange(void *data, int start, int end)
+{
+    MoveBulletChunksJob *job = (MoveBulletChunksJob *)data;
+    int despawned = 0;
+
+    for (int c = start; c < end; c++)
+    {
+        const EcsChunkView &view = job->views[c];
+
+        despawned += MoveBullets(&view.Get<BulletX>()->value, &view.Get<BulletY>()->value,
+                                 &view.Get<BulletDirectionX>()->value, &view.Get<BulletDirectionY>()->value,
+                                 &view.Get<BulletSpeed>()->value, &view.Get<BulletAlive>()->value, view.count, job->dt, job->bounds);
+    }
+
+    if (despawned > 0) AtomicAdd(&job->despawned, despawned);
+}
+
+// Copy bullet segments of this tick to contiguous arrays, grid is indexed by bullet query position
+static void GatherBulletMotions(int count)
+{
+    if (count > collisionCapacity)
+    {
+        collisionX = (float *)realloc(collisionX, count*sizeof(float));
+        collisionY = (float *)realloc(collisionY, count*sizeof(float));
+        collisionMotionX = (float *)realloc(collisionMotionX, count*sizeof(float));
+        collisionMotionY = (float *)realloc(collisionMotionY, count*sizeof(float));
+        collisionCapacity = count;
+    }
+
+    for (const EcsChunkView &view : bulletChunks)
+    {
+        const float *directionX = &view.Get<BulletDirectionX>()->value;
+        const float *directionY = &view.Get<BulletDirectionY>()->value;
+        const float *speed = &view.Get<BulletSpeed>()->value;
+        float *startX = collisionX + view.first;
+        float *startY = collisionY + view.first;
+        float *motionX = collisionMotionX + view.first;
+        float *motionY = collisionMotionY + view.first;
+
+        for (int i = 0; i < view.count; i++)
+        {
+            float step = speed[i]*state.tickTime;
+            motionX[i] = directionX[i]*step;
+            motionY[i] = directionY[i]*step;
+        }
+
+        if (state.projectileMode == PROJECTILE_ANALYTIC)
+        {
+            // Positions on previous tick, the only time they are needed
+            GetBulletPositionsAt(&view.Get<BulletOriginX>()->value, &view.Get<BulletOriginY>()->value, directionX, directionY, speed,
+                                 &view.Get<BulletSpawnTick>()->value, view.count, state.tick, 0.0f, state.tickTime, startX, startY);
+        }
+        else
+        {
+            // Bullets are moved after collisions, they are still at start of tick
+            memcpy(startX, &view.Get<BulletX>()->value, view.count*sizeof(float));
+            memcpy(startY, &view.Get<BulletY>()->value, view.count*sizeof(float));
+        }
+    }
+}
+
+static const EcsChunkView &GetBulletChunk(int index)
+{
+    // Last chunk starting at or before index
+    auto view = std::upper_bound(bulletChunks.begin(), bulletChunks.end(), index,
+                                 [](int i, const EcsChunkView &chunk) { return i < chunk.first; }) - 1;
+
+    return *view;
+}
+
+static void Fire(Vector2 origin, float speed, Vector2 target)
+{
+    // Direction never changes, normalize it once here
+    float dx = target.x - origin.x;
+    float dy = target.y - origin.y;
+    float length = sqrtf(dx*dx + dy*dy);
+
+    if (length > 0.0f)
+    {
+        dx /= length;
+        dy /= length;
+    }
+    else    // Target on top of origin, shoot straight up
+    {
+        dx = 0.0f;
+        dy = -1.0f;
+    }
+
+    Entity bullet = INVALID_ENTITY;
+
+    if (state.projectileMode == PROJECTILE_ANALYTIC)
+    {
+        bullet = world.Create(BulletOriginX{ origin.x }, BulletOriginY{ origin.y }, BulletDirectionX{ dx }, BulletDirectionY{ dy },
+                              BulletSpeed{ speed }, BulletSpawnTick{ state.tick }, BulletAlive{ 1 });
+
+        if (bullet.slot != INVALID_ENTITY.slot) PushBulletExpiry(bullet, origin, Vector2{ dx, dy }, speed);
+    }
+    else
+    {
+        bullet = world.Create(BulletX{ origin.x }, BulletY{ origin.y }, BulletDirectionX{ dx }, BulletDirectionY{ dy },
+                              BulletSpeed{ speed }, BulletAlive{ 1 });
+    }
+
+    if (bullet.slot != INVALID_ENTITY.slot)
+    {
+        state.spawnCount++;
+        tickEvents.push_back({ GAME_EVENT_SHOT, origin, Vector2{ dx, dy } });
+    }
+}
+
+// Bullets that never leave the field (speed 0) are not queued
+static void PushBulletExpiry(Entity bullet, Vector2 origin, Vector2 direction, float speed)
+{
+    int tick = GetBulletExitTick(origin, direction, speed, state.tick, state.tickTime, state.field);
+    if (tick == INT_MAX) return;
+
+    bulletExpiries.push_back(BulletExpiry{ tick, bullet });
+    std::push_heap(bulletExpiries.begin(), bulletExpiries.end(), IsLaterExpiry);
+}
+
+// Heap order, earliest tick on top
+static bool IsLaterExpiry(const BulletExpiry &a, const BulletExpiry &b)
+{
+    return a.tick > b.tick;
+}
+
+static unsigned int HashBytes(unsigned int hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;      // FNV-1a prime
+    }
+
+    return hash;
+}
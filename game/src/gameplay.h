@@ -0,0 +1,118 @@
+/**********************************************************************************************
+*
+*   Gameplay - Simulation, independent of window and input devices
+*
+*   Everything that happens on a gameplay tick lives here: player movement, firing and
+*   bullets. Input is handed in as a GameInput and the play field is given at init, so
+*   the simulation runs the same inside the game window or headless (shooter_bench).
+*
+*   Player, emitters and bullets are entities of an archetype ECS (ecs.hpp), bullets are
+*   exposed by chunk so renderers walk the same arrays the simulation does. Emitters fire
+*   volleys of a bullet pattern (patterns.h), aimed at the player when the pattern is.
+*
+*   Bullets fly straight, so by default they are not moved every tick: their position is a
+*   closed form of spawn tick, evaluated only to collide and to draw, and the tick they leave
+*   the field is computed once at spawn and kept in a min-heap. Bullets nothing collides
+*   with cost nothing per tick. PROJECTILE_INTEGRATED steps every bullet every tick instead.
+*
+*   A tick can be saved to one contiguous buffer and loaded back (rollback, replays from the
+*   middle): a plain state block, then entities packed by archetype, then the expiry heap.
+*   Equal simulations save equal bytes, so two snapshots can be compared byte per byte.
+*   NOTE: Snapshots are only comparable within one binary: archetypes are saved by ECS
+*   component id, and ids follow the order components are first used in. Replays store
+*   inputs and value checksums (input_log.h), not snapshots, so they are not affected.
+*
+*   Shots and hits of the last tick are also listed as events, for effects (particles.h).
+*   Events are an output only: they are not saved and the simulation never reads them.
+*
+**********************************************************************************************/
+
+#ifndef GAMEPLAY_H
+#define GAMEPLAY_H
+
+#include "raylib.h"
+#include "bullets.h"
+#include "patterns.h"
+
+#include <stddef.h>         // Required for: size_t
+
+#define MAX_TARGETS     128
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Player input for one tick
+typedef struct GameInput {
+    Vector2 cursor;         // Aim position, in play field coordinates
+    bool moveLeft;
+    bool moveRight;
+    bool fire;              // Fire one bullet towards cursor on this tick
+} GameInput;
+
+// How bullet positions are advanced, see SetGameplayProjectileMode()
+typedef enum ProjectileMode {
+    PROJECTILE_ANALYTIC = 0,    // Computed from spawn tick when needed, expire on a precomputed tick
+    PROJECTILE_INTEGRATED,      // Moved and bounds checked every tick
+} ProjectileMode;
+
+// Target bullets can hit, a circle or a box
+typedef struct GameTarget {
+    Vector2 center;
+    Vector2 halfSize;       // Box targets, zero for circles
+    float radius;           // Circle targets, zero for boxes
+    int hits;               // Bullets that hit this target
+} GameTarget;
+
+// Something effects react to, see GetGameplayEvents()
+typedef enum GameEventType {
+    GAME_EVENT_SHOT = 0,        // Player fired, position is the muzzle
+    GAME_EVENT_HIT,             // Bullet hit a target, position is the first contact
+} GameEventType;
+
+typedef struct GameEvent {
+    GameEventType type;
+    Vector2 position;
+    Vector2 direction;      // Shots: bullet direction, hits: opposite to bullet motion
+} GameEvent;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Gameplay Functions Declaration
+//----------------------------------------------------------------------------------
+void InitGameplay(Rectangle field);             // Reset simulation, field replaces screen size queries
+void UnloadGameplay(void);
+void SetGameplayBulletBudget(size_t budget);    // Bytes for entity storage, default BULLETS_DEFAULT_BUDGET
+void SetGameplayProjectileMode(ProjectileMode mode);   // Applied on next InitGameplay(), default PROJECTILE_ANALYTIC
+void UpdateGameplay(GameInput input, float dt); // Simulate one tick of dt seconds
+Vector2 GetPlayerPosition(float alpha);         // Interpolated between previous (alpha 0) and current (alpha 1) tick
+float GetPlayerSize(void);
+void SetGameplayPatterns(const BulletPatterns *patterns);      // Patterns emitters use, must outlive the emitters
+bool AddGameplayEmitter(int pattern, Vector2 position);         // Returns false if pattern is unknown or budget is reached
+int AddGameplayPatternEmitters(const BulletPatterns *patterns); // Sets patterns, adds the emitters they list on the field, returns emitters added
+int GetGameplayEmitterCount(void);
+int GetGameplayBulletCount(void);
+int GetGameplaySpawnCount(void);                // Bullets spawned since InitGameplay(), player and emitters
+int GetGameplayDroppedSpawns(void);             // Spawns refused since InitGameplay() because the bullet budget was reached
+int GetGameplayBulletChunkCount(void);
+int GetGameplayBulletRenderPositions(int chunk, float alpha, float dt,          // Positions of a chunk between previous (alpha 0) and
+                                     float *renderX, float *renderY);           // current (alpha 1) tick, returns bullets in chunk (up to BULLETS_PER_CHUNK)
+int AddGameplayTarget(Vector2 center, float radius);   // Returns target index, -1 if MAX_TARGETS reached
+int AddGameplayBoxTarget(Rectangle box);               // Same as above, for walls and other boxes
+int GetGameplayTargetCount(void);
+GameTarget GetGameplayTarget(int index);
+int GetGameplayTick(void);                      // Ticks simulated since InitGameplay()
+size_t GetGameplayMemory(void);                 // Bytes allocated by the simulation
+unsigned int GetGameplayChecksum(void);         // Hash of simulation state, equal states give equal values
+int GetGameplayStateSize(void);                 // Bytes SaveGameplayState() needs for current tick
+int SaveGameplayState(void *data, int capacity);        // Returns bytes written, 0 if capacity is too small
+bool LoadGameplayState(const void *data, int size);     // Back to a saved tick, after InitGameplay() on the same patterns
+int GetGameplayEvents(const GameEvent **events);        // Events of last tick, valid until next update, returns their number
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GAMEPLAY_H
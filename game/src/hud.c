@@ -0,0 +1,196 @@
+/**********************************************************************************************
+*
+*   HUD - Text widgets cached in a render texture
+*
+*   See hud.h for an overview.
+*
+*   Layer is rendered with premultiplied alpha (text color blended, coverage kept as alpha)
+*   and drawn with BLEND_ALPHA_PREMULTIPLY, so antialiased glyph edges look the same as text
+*   drawn straight to the screen.
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+#include "rlgl.h"           // Required for: rlSetBlendFactorsSeparate()
+#include "hud.h"
+
+#include <stdio.h>          // Required for: snprintf()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct HudWidget {
+    const char *format;
+    int posX;
+    int posY;
+    int fontSize;
+    Color color;
+    int value;
+    char text[HUD_MAX_TEXT];
+    Rectangle bounds;           // Area covered in the layer, empty until rendered
+    bool dirty;
+} HudWidget;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static RenderTexture2D layer = { 0 };
+static HudWidget widgets[HUD_MAX_WIDGETS] = { 0 };
+static int widgetCount = 0;
+static bool layerDirty = false;         // Whole layer must be rendered again
+static int renderCount = 0;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void FormatHudWidget(HudWidget *widget);
+static void RenderHudArea(Rectangle area);     // Clear area and render widgets overlapping it
+static Rectangle GetRectangleUnion(Rectangle a, Rectangle b);
+
+//----------------------------------------------------------------------------------
+// HUD Functions Definition
+//----------------------------------------------------------------------------------
+void LoadHud(void)
+{
+    UnloadHud();
+
+    layer = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+    layerDirty = true;
+    renderCount = 0;
+}
+
+void UnloadHud(void)
+{
+    if (layer.id != 0) UnloadRenderTexture(layer);
+    layer = (RenderTexture2D){ 0 };
+    widgetCount = 0;
+}
+
+int AddHudWidget(const char *format, int posX, int posY, int fontSize, Color color)
+{
+    if (widgetCount >= HUD_MAX_WIDGETS) return -1;
+
+    HudWidget *widget = &widgets[widgetCount];
+    *widget = (HudWidget){ 0 };
+    widget->format = format;
+    widget->posX = posX;
+    widget->posY = posY;
+    widget->fontSize = fontSize;
+    widget->color = color;
+    widget->dirty = true;
+
+    return widgetCount++;
+}
+
+void SetHudValue(int widget, int value)
+{
+    if ((widget < 0) || (widget >= widgetCount) || (widgets[widget].value == value)) return;
+
+    widgets[widget].value = value;
+    widgets[widget].dirty = true;
+}
+
+void DrawHud(void)
+{
+    if (layer.id == 0) return;
+
+    // Layer follows window size, its content is lost with it
+    if ((layer.texture.width != GetScreenWidth()) || (layer.texture.height != GetScreenHeight()))
+    {
+        UnloadRenderTexture(layer);
+        layer = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+        layerDirty = true;
+    }
+
+    bool changed = layerDirty;
+    for (int i = 0; (i < widgetCount) && !changed; i++) changed = widgets[i].dirty;
+
+    if (changed)
+    {
+        BeginTextureMode(layer);
+        rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+
+        if (layerDirty)
+        {
+            for (int i = 0; i < widgetCount; i++) FormatHudWidget(&widgets[i]);
+            RenderHudArea((Rectangle){ 0, 0, (float)layer.texture.width, (float)layer.texture.height });
+            layerDirty = false;
+        }
+
+        for (int i = 0; i < widgetCount; i++)
+        {
+            if (!widgets[i].dirty) continue;
+
+            // Old text area must be cleared too, new text may be shorter
+            Rectangle previous = widgets[i].bounds;
+            FormatHudWidget(&widgets[i]);
+            RenderHudArea(GetRectangleUnion(previous, widgets[i].bounds));
+        }
+
+        EndBlendMode();
+        EndTextureMode();
+    }
+
+    // NOTE: Render texture is stored upside down, source height is negative to flip it
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTextureRec(layer.texture, (Rectangle){ 0, 0, (float)layer.texture.width, -(float)layer.texture.height }, (Vector2){ 0, 0 }, WHITE);
+    EndBlendMode();
+}
+
+int GetHudRenderCount(void)
+{
+    return renderCount;
+}
+
+// Same layout as compositor layers, see GetCompositorMemory()
+size_t GetHudMemory(void)
+{
+    if (layer.id == 0) return 0;
+    return (size_t)layer.texture.width*layer.texture.height*(4 + 4);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Text and area of widget value, widget is clean once its area is rendered
+static void FormatHudWidget(HudWidget *widget)
+{
+    snprintf(widget->text, HUD_MAX_TEXT, widget->format, widget->value);
+    widget->bounds = (Rectangle){ (float)widget->posX, (float)widget->posY, (float)MeasureText(widget->text, widget->fontSize), (float)widget->fontSize };
+    widget->dirty = false;
+}
+
+// NOTE: Clear is limited by scissor test, widgets outside area are left untouched;
+// a dirty widget drawn here with its old text is rendered again with its own area
+static void RenderHudArea(Rectangle area)
+{
+    if ((area.width <= 0) || (area.height <= 0)) return;
+
+    BeginScissorMode((int)area.x, (int)area.y, (int)area.width + 1, (int)area.height + 1);
+    ClearBackground(BLANK);
+
+    for (int i = 0; i < widgetCount; i++)
+    {
+        if (!CheckCollisionRecs(widgets[i].bounds, area)) continue;
+
+        DrawText(widgets[i].text, widgets[i].posX, widgets[i].posY, widgets[i].fontSize, widgets[i].color);
+        renderCount++;
+    }
+
+    EndScissorMode();
+}
+
+static Rectangle GetRectangleUnion(Rectangle a, Rectangle b)
+{
+    if ((a.width <= 0) || (a.height <= 0)) return b;
+    if ((b.width <= 0) || (b.height <= 0)) return a;
+
+    float left = (a.x < b.x)? a.x : b.x;
+    float top = (a.y < b.y)? a.y : b.y;
+    float right = (a.x + a.width > b.x + b.width)? a.x + a.width : b.x + b.width;
+    float bottom = (a.y + a.height > b.y + b.height)? a.y + a.height : b.y + b.height;
+
+    return (Rectangle){ left, top, right - left, bottom - top };
+}
@@ -0,0 +1,41 @@
+/**********************************************************************************************
+*
+*   HUD - Text widgets cached in a render texture
+*
+*   Widgets are rendered into a screen sized render texture, which is drawn every frame as a
+*   single textured quad. A widget is formatted and rendered again only when its value
+*   changes: its old and new area are cleared and every widget overlapping them is redrawn.
+*   Frames where no value changed cost one draw, whatever the number of widgets.
+*
+**********************************************************************************************/
+
+#ifndef HUD_H
+#define HUD_H
+
+#include "raylib.h"
+
+#include <stddef.h>         // Required for: size_t
+
+#define HUD_MAX_WIDGETS     32
+#define HUD_MAX_TEXT        64      // Formatted widget text, including terminator
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// HUD Functions Declaration
+//----------------------------------------------------------------------------------
+void LoadHud(void);                 // Requires a window, removes every widget
+void UnloadHud(void);
+int AddHudWidget(const char *format, int posX, int posY, int fontSize, Color color);   // Format takes one int, returns widget id, -1 on failure
+void SetHudValue(int widget, int value);    // Widget is rendered again only if value changed
+void DrawHud(void);                 // Render changed widgets, then draw the cached layer
+int GetHudRenderCount(void);        // Widget renders since LoadHud()
+size_t GetHudMemory(void);          // Video memory of the layer, color and depth buffers
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HUD_H
@@ -0,0 +1,177 @@
+/**********************************************************************************************
+*
+*   Input Log - Per-tick gameplay input recording
+*
+*   See input_log.h for an overview.
+*
+**********************************************************************************************/
+
+#include "input_log.h"
+
+#include <stdio.h>          // Required for: FILE, fopen(), fread(), fwrite(), fclose()
+#include <stdlib.h>         // Required for: malloc(), realloc(), free()
+#include <string.h>         // Required for: memcpy(), memcmp()
+
+#define INPUT_LOG_VERSION       1
+#define INPUT_LOG_HEADER_SIZE   32
+#define INPUT_LOG_TICK_SIZE     13
+
+#define INPUT_FLAG_LEFT     0x01
+#define INPUT_FLAG_RIGHT    0x02
+#define INPUT_FLAG_FIRE     0x04
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned char *WriteUInt(unsigned char *data, unsigned int value);
+static unsigned char *WriteFloat(unsigned char *data, float value);
+static const unsigned char *ReadUInt(const unsigned char *data, unsigned int *value);
+static const unsigned char *ReadFloat(const unsigned char *data, float *value);
+
+//----------------------------------------------------------------------------------
+// Input Log Functions Definition
+//----------------------------------------------------------------------------------
+InputLog LoadInputLog(const char *fileName)
+{
+    InputLog log = { 0 };
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return log;
+
+    unsigned char header[INPUT_LOG_HEADER_SIZE] = { 0 };
+    unsigned int version = 0;
+    unsigned int count = 0;
+
+    if ((fread(header, 1, INPUT_LOG_HEADER_SIZE, file) == INPUT_LOG_HEADER_SIZE) && (memcmp(header, "SHIN", 4) == 0))
+    {
+        const unsigned char *data = ReadUInt(header + 4, &version);
+        data = ReadFloat(data, &log.field.x);
+        data = ReadFloat(data, &log.field.y);
+        data = ReadFloat(data, &log.field.width);
+        data = ReadFloat(data, &log.field.height);
+        data = ReadFloat(data, &log.tickTime);
+        ReadUInt(data, &count);
+    }
+
+    unsigned char *ticks = ((version == INPUT_LOG_VERSION) && (count > 0))? (unsigned char *)malloc((size_t)count*INPUT_LOG_TICK_SIZE) : NULL;
+
+    if ((ticks != NULL) && (fread(ticks, INPUT_LOG_TICK_SIZE, count, file) == count))
+    {
+        log.ticks = (InputLogTick *)malloc(count*sizeof(InputLogTick));
+        log.count = count;
+        log.capacity = count;
+
+        const unsigned char *data = ticks;
+        for (int i = 0; i < log.count; i++)
+        {
+            GameInput *input = &log.ticks[i].input;
+
+            data = ReadFloat(data, &input->cursor.x);
+            data = ReadFloat(data, &input->cursor.y);
+            input->moveLeft = (*data & INPUT_FLAG_LEFT) != 0;
+            input->moveRight = (*data & INPUT_FLAG_RIGHT) != 0;
+            input->fire = (*data & INPUT_FLAG_FIRE) != 0;
+            data = ReadUInt(data + 1, &log.ticks[i].checksum);
+        }
+    }
+
+    free(ticks);
+    fclose(file);
+
+    return log;
+}
+
+void UnloadInputLog(InputLog log)
+{
+    free(log.ticks);
+}
+
+bool SaveInputLog(InputLog log, const char *fileName)
+{
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL) return false;
+
+    unsigned char header[INPUT_LOG_HEADER_SIZE] = { 'S', 'H', 'I', 'N' };
+    unsigned char *data = WriteUInt(header + 4, INPUT_LOG_VERSION);
+    data = WriteFloat(data, log.field.x);
+    data = WriteFloat(data, log.field.y);
+    data = WriteFloat(data, log.field.width);
+    data = WriteFloat(data, log.field.height);
+    data = WriteFloat(data, log.tickTime);
+    WriteUInt(data, (unsigned int)log.count);
+
+    bool success = (fwrite(header, 1, INPUT_LOG_HEADER_SIZE, file) == INPUT_LOG_HEADER_SIZE);
+
+    for (int i = 0; success && (i < log.count); i++)
+    {
+        unsigned char tick[INPUT_LOG_TICK_SIZE] = { 0 };
+        GameInput input = log.ticks[i].input;
+
+        data = WriteFloat(tick, input.cursor.x);
+        data = WriteFloat(data, input.cursor.y);
+        *data++ = (input.moveLeft? INPUT_FLAG_LEFT : 0) | (input.moveRight? INPUT_FLAG_RIGHT : 0) | (input.fire? INPUT_FLAG_FIRE : 0);
+        WriteUInt(data, log.ticks[i].checksum);
+
+        success = (fwrite(tick, 1, INPUT_LOG_TICK_SIZE, file) == INPUT_LOG_TICK_SIZE);
+    }
+
+    fclose(file);
+
+    return success;
+}
+
+// Add one tick, storage doubles when full
+void AppendInputLog(InputLog *log, GameInput input, unsigned int checksum)
+{
+    if (log->count >= log->capacity)
+    {
+        int capacity = (log->capacity > 0)? log->capacity*2 : 1024;
+        InputLogTick *ticks = (InputLogTick *)realloc(log->ticks, capacity*sizeof(InputLogTick));
+        if (ticks == NULL) return;
+
+        log->ticks = ticks;
+        log->capacity = capacity;
+    }
+
+    log->ticks[log->count].input = input;
+    log->ticks[log->count].checksum = checksum;
+    log->count++;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Little-endian whatever the host is, logs are shared between machines
+static unsigned char *WriteUInt(unsigned char *data, unsigned int value)
+{
+    data[0] = (unsigned char)(value & 0xff);
+    data[1] = (unsigned char)((value >> 8) & 0xff);
+    data[2] = (unsigned char)((value >> 16) & 0xff);
+    data[3] = (unsigned char)((value >> 24) & 0xff);
+
+    return data + 4;
+}
+
+static unsigned char *WriteFloat(unsigned char *data, float value)
+{
+    unsigned int bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+
+    return WriteUInt(data, bits);
+}
+
+static const unsigned char *ReadUInt(const unsigned char *data, unsigned int *value)
+{
+    *value = (unsigned int)data[0] | ((unsigned int)data[1] << 8) | ((unsigned int)data[2] << 16) | ((unsigned int)data[3] << 24);
+
+    return data + 4;
+}
+
+static const unsigned char *ReadFloat(const unsigned char *data, float *value)
+{
+    unsigned int bits = 0;
+    data = ReadUInt(data, &bits);
+    memcpy(value, &bits, sizeof(bits));
+
+    return data;
+}
@@ -0,0 +1,53 @@
+/**********************************************************************************************
+*
+*   Input Log - Per-tick gameplay input recording
+*
+*   Stores the GameInput of every gameplay tick along with a checksum of the simulation
+*   state after that tick. Feeding the same inputs to a freshly initialized simulation must
+*   give the same checksums, any difference means the build is not deterministic (or the
+*   simulation changed) starting at that tick.
+*
+*   File layout, little-endian:
+*     header    "SHIN", version (u32), field x/y/width/height (f32), tick time (f32), ticks (u32)
+*     per tick  cursor x/y (f32), flags (u8: move left, move right, fire), checksum (u32)
+*
+**********************************************************************************************/
+
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include "gameplay.h"
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct InputLogTick {
+    GameInput input;
+    unsigned int checksum;      // GetGameplayChecksum() after the tick
+} InputLogTick;
+
+typedef struct InputLog {
+    Rectangle field;            // InitGameplay() field, replay must use the same
+    float tickTime;             // Seconds per tick, replay must use the same
+    InputLogTick *ticks;
+    int count;
+    int capacity;
+} InputLog;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Input Log Functions Declaration
+//----------------------------------------------------------------------------------
+InputLog LoadInputLog(const char *fileName);                // Returns log with no ticks on failure
+void UnloadInputLog(InputLog log);
+bool SaveInputLog(InputLog log, const char *fileName);
+void AppendInputLog(InputLog *log, GameInput input, unsigned int checksum);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INPUT_LOG_H
@@ -0,0 +1,271 @@
+/**********************************************************************************************
+*
+*   Jobs - Work-stealing job system
+*
+*   See jobs.h for an overview.
+*
+*   NOTE: Deques are guarded by a mutex each, jobs are coarse ranges so the lock is never
+*   contended enough to need a lock-free deque
+*
+**********************************************************************************************/
+
+#include "jobs.h"
+#include "threads.h"
+
+#include <stdbool.h>        // Required for: bool
+#include <stddef.h>         // Required for: NULL, size_t
+
+#if defined(_MSC_VER)
+    #define THREAD_LOCAL __declspec(thread)
+#else
+    #define THREAD_LOCAL __thread
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct Job {
+    JobFunc func;
+    void *data;
+    int start;
+    int end;
+    volatile int *pending;      // Jobs left in the ParallelFor() this job belongs to
+} Job;
+
+// Jobs in [top, bottom), owner works at the bottom, thieves take from the top
+typedef struct JobQueue {
+    Mutex *lock;
+    Job jobs[JOB_QUEUE_SIZE];
+    int top;
+    int bottom;
+} JobQueue;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static JobQueue queues[MAX_JOB_WORKERS] = { 0 };
+static Thread *workers[MAX_JOB_WORKERS] = { 0 };
+static int workersCount = 0;                // Including main thread, 0 if not initialized
+static volatile int running = 0;
+static volatile int queuedJobs = 0;         // Jobs waiting in any queue, idle workers sleep at 0
+static Mutex *sleepLock = NULL;
+static CondVar *wakeUp = NULL;
+
+static THREAD_LOCAL int workerIndex = 0;    // Queue owned by current thread, main thread is 0
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static int WorkerMain(void *arg);
+static bool PushJob(JobQueue *queue, Job job);
+static bool PopJob(JobQueue *queue, Job *job);
+static bool StealJob(JobQueue *queue, Job *job);
+static bool FindJob(int worker, Job *job);
+static void RunJob(const Job *job);
+
+//----------------------------------------------------------------------------------
+// Jobs Functions Definition
+//----------------------------------------------------------------------------------
+void InitJobSystem(int threadCount)
+{
+    if (workersCount > 0) return;
+
+    if (threadCount <= 0) threadCount = GetCpuCount();
+    if (threadCount > MAX_JOB_WORKERS) threadCount = MAX_JOB_WORKERS;
+
+    sleepLock = LoadMutex();
+    wakeUp = LoadCondVar();
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        queues[i].lock = LoadMutex();
+        queues[i].top = 0;
+        queues[i].bottom = 0;
+    }
+
+    workersCount = threadCount;
+    workerIndex = 0;
+    AtomicStore(&queuedJobs, 0);
+    AtomicStore(&running, 1);
+
+    // NOTE: A worker failing to start only means fewer threads, its queue stays empty
+    for (int i = 1; i < threadCount; i++) workers[i] = StartThread(WorkerMain, (void *)(size_t)i);
+}
+
+void CloseJobSystem(void)
+{
+    if (workersCount == 0) return;
+
+    LockMutex(sleepLock);
+    AtomicStore(&running, 0);
+    BroadcastCondVar(wakeUp);
+    UnlockMutex(sleepLock);
+
+    for (int i = 1; i < workersCount; i++)
+    {
+        JoinThread(workers[i]);
+        workers[i] = NULL;
+    }
+
+    for (int i = 0; i < workersCount; i++)
+    {
+        UnloadMutex(queues[i].lock);
+        queues[i].lock = NULL;
+    }
+
+    UnloadCondVar(wakeUp);
+    UnloadMutex(sleepLock);
+    wakeUp = NULL;
+    sleepLock = NULL;
+    workersCount = 0;
+}
+
+int GetJobThreadCount(void)
+{
+    return (workersCount > 0)? workersCount : 1;
+}
+
+void ParallelFor(int count, int grainSize, JobFunc func, void *data)
+{
+    if (count <= 0) return;
+    if (grainSize < 1) grainSize = 1;
+
+    int jobsCount = (count + grainSize - 1)/grainSize;
+
+    // Same ranges as the threaded path, only run in order on this thread
+    if ((workersCount <= 1) || (jobsCount == 1))
+    {
+        for (int start = 0; start < count; start += grainSize)
+        {
+            int end = (start + grainSize < count)? start + grainSize : count;
+            func(data, start, end);
+        }
+        return;
+    }
+
+    volatile int pending = jobsCount;
+    int self = workerIndex;
+
+    for (int start = 0; start < count; start += grainSize)
+    {
+        Job job = { func, data, start, (start + grainSize < count)? start + grainSize : count, &pending };
+
+        // Queue full, do it right away
+        if (!PushJob(&queues[self], job)) RunJob(&job);
+    }
+
+    LockMutex(sleepLock);
+    BroadcastCondVar(wakeUp);
+    UnlockMutex(sleepLock);
+
+    // Help until all ranges are done, possibly running jobs of other callers
+    while (AtomicLoad(&pending) > 0)
+    {
+        Job job = { 0 };
+
+        if (FindJob(self, &job)) RunJob(&job);
+        else YieldThread();
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static int WorkerMain(void *arg)
+{
+    workerIndex = (int)(size_t)arg;
+
+    while (AtomicLoad(&running))
+    {
+        Job job = { 0 };
+
+        if (FindJob(workerIndex, &job))
+        {
+            RunJob(&job);
+            continue;
+        }
+
+        // Nothing to do, sleep until more jobs are queued
+        // NOTE: queuedJobs is checked with sleepLock held, pushers broadcast with it held too
+        LockMutex(sleepLock);
+        while (AtomicLoad(&running) && (AtomicLoad(&queuedJobs) == 0)) WaitCondVar(wakeUp, sleepLock);
+        UnlockMutex(sleepLock);
+    }
+
+    return 0;
+}
+
+static bool PushJob(JobQueue *queue, Job job)
+{
+    LockMutex(queue->lock);
+
+    if ((queue->bottom - queue->top) >= JOB_QUEUE_SIZE)
+    {
+        UnlockMutex(queue->lock);
+        return false;
+    }
+
+    queue->jobs[queue->bottom & (JOB_QUEUE_SIZE - 1)] = job;
+    queue->bottom++;
+    AtomicAdd(&queuedJobs, 1);
+
+    UnlockMutex(queue->lock);
+    return true;
+}
+
+// Owner side, newest job first
+static bool PopJob(JobQueue *queue, Job *job)
+{
+    bool found = false;
+
+    LockMutex(queue->lock);
+
+    if (queue->bottom > queue->top)
+    {
+        queue->bottom--;
+        *job = queue->jobs[queue->bottom & (JOB_QUEUE_SIZE - 1)];
+        AtomicAdd(&queuedJobs, -1);
+        found = true;
+    }
+
+    UnlockMutex(queue->lock);
+    return found;
+}
+
+// Thief side, oldest job first
+static bool StealJob(JobQueue *queue, Job *job)
+{
+    bool found = false;
+
+    LockMutex(queue->lock);
+
+    if (queue->bottom > queue->top)
+    {
+        *job = queue->jobs[queue->top & (JOB_QUEUE_SIZE - 1)];
+        queue->top++;
+        AtomicAdd(&queuedJobs, -1);
+        found = true;
+    }
+
+    UnlockMutex(queue->lock);
+    return found;
+}
+
+// Own queue first, then steal going round the other workers
+static bool FindJob(int worker, Job *job)
+{
+    if (PopJob(&queues[worker], job)) return true;
+
+    for (int i = 1; i < workersCount; i++)
+    {
+        if (StealJob(&queues[(worker + i)%workersCount], job)) return true;
+    }
+
+    return false;
+}
+
+static void RunJob(const Job *job)
+{
+    job->func(job->data, job->start, job->end);
+    AtomicAdd(job->pending, -1);
+}
@@ -0,0 +1,46 @@
+/**********************************************************************************************
+*
+*   Jobs - Work-stealing job system
+*
+*   One worker thread per extra core, the calling thread (main) is worker 0 and works too
+*   while it waits. Every worker owns a deque: it pushes and pops jobs at the bottom, idle
+*   workers steal from the top of the others.
+*
+*   ParallelFor() splits [0, count) in ranges of grainSize elements. Ranges only depend on
+*   count and grainSize, never on the number of threads, so a job function that writes
+*   disjoint outputs per range gives the same results with any thread count.
+*
+*   Without InitJobSystem() (or with a single core) ParallelFor() runs the ranges inline.
+*
+**********************************************************************************************/
+
+#ifndef JOBS_H
+#define JOBS_H
+
+#define MAX_JOB_WORKERS     64          // Threads, including the main one
+#define JOB_QUEUE_SIZE      1024        // Jobs per worker deque, power of two
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef void (*JobFunc)(void *data, int start, int end);
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Jobs Functions Declaration
+//----------------------------------------------------------------------------------
+void InitJobSystem(int threadCount);    // Threads including the caller, 0 to use every core
+void CloseJobSystem(void);
+int GetJobThreadCount(void);            // Threads running jobs, including the caller
+
+// Run func over [0, count) split in ranges of grainSize, returns when every range is done
+void ParallelFor(int count, int grainSize, JobFunc func, void *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JOBS_H
@@ -0,0 +1,83 @@
+/**********************************************************************************************
+*
+*   Mapped File - Read-only memory mapped files
+*
+*   NOTE: This module must not include raylib.h, windows.h declarations collide with it
+*
+**********************************************************************************************/
+
+#include "mapped_file.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>        // Required for: CreateFileMapping(), MapViewOfFile()
+#else
+    #include <fcntl.h>          // Required for: open()
+    #include <sys/mman.h>       // Required for: mmap(), munmap()
+    #include <sys/stat.h>       // Required for: fstat()
+    #include <unistd.h>         // Required for: close()
+#endif
+
+//----------------------------------------------------------------------------------
+// Mapped File Functions Definition
+//----------------------------------------------------------------------------------
+MappedFile MapFile(const char *fileName)
+{
+    MappedFile file = { 0 };
+
+#if defined(_WIN32)
+    HANDLE handle = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) return file;
+
+    LARGE_INTEGER size = { 0 };
+    HANDLE mapping = NULL;
+
+    if (GetFileSizeEx(handle, &size) && (size.QuadPart > 0)) mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    // Mapping keeps the file open, its handle is not needed anymore
+    CloseHandle(handle);
+    if (mapping == NULL) return file;
+
+    file.data = (const unsigned char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (file.data == NULL) CloseHandle(mapping);
+    else
+    {
+        file.size = (size_t)size.QuadPart;
+        file.handle = mapping;
+    }
+#else
+    int descriptor = open(fileName, O_RDONLY);
+    if (descriptor < 0) return file;
+
+    struct stat info = { 0 };
+
+    if ((fstat(descriptor, &info) == 0) && (info.st_size > 0))
+    {
+        void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+        if (data != MAP_FAILED)
+        {
+            file.data = (const unsigned char *)data;
+            file.size = (size_t)info.st_size;
+        }
+    }
+
+    // Mapping stays valid after the descriptor is closed
+    close(descriptor);
+#endif
+
+    return file;
+}
+
+void UnmapFile(MappedFile file)
+{
+    if (file.data == NULL) return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(file.data);
+    CloseHandle((HANDLE)file.handle);
+#else
+    munmap((void *)file.data, file.size);
+#endif
+}
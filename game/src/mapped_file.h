@@ -0,0 +1,39 @@
+/**********************************************************************************************
+*
+*   Mapped File - Read-only memory mapped files
+*
+*   The file contents are mapped in the process address space instead of being read into
+*   a buffer: nothing is copied, pages are loaded by the OS on first access and can be
+*   dropped again under memory pressure, since the file itself backs them.
+*
+**********************************************************************************************/
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <stddef.h>         // Required for: size_t
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct MappedFile {
+    const unsigned char *data;  // NULL if mapping failed
+    size_t size;
+    void *handle;               // Platform mapping handle
+} MappedFile;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Mapped File Functions Declaration
+//----------------------------------------------------------------------------------
+MappedFile MapFile(const char *fileName);       // Map whole file read-only
+void UnmapFile(MappedFile file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MAPPED_FILE_H
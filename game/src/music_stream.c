@@ -0,0 +1,252 @@
+/**********************************************************************************************
+*
+*   Music Stream - OGG music decoded on its own thread
+*
+*   See music_stream.h for an overview.
+*
+*   Ring positions are frame counters that only grow (and wrap around), the streaming thread
+*   owns ringWrite and the audio callback owns ringRead, frames between them are ready.
+*
+*   NOTE: Decoder is the stb_vorbis compiled into raylib, only its declarations are included
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+#include "music_stream.h"
+#include "threads.h"
+#include "timing.h"
+
+#define STB_VORBIS_HEADER_ONLY
+#include "stb_vorbis.c"     // Required for: stb_vorbis_open_memory(), stb_vorbis_get_samples_short_interleaved()
+
+#include <stdlib.h>         // Required for: calloc(), free()
+#include <string.h>         // Required for: memcpy(), memset()
+
+#define MUSIC_DECODE_CHUNK      4096    // Frames decoded at once, at most
+#define MUSIC_STREAM_SLEEP_MS   5       // Streaming thread wait when ring is full
+#define MUSIC_MIN_BUFFER        (2*MUSIC_DECODE_CHUNK)
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static stb_vorbis *vorbis = NULL;
+static unsigned char *fileData = NULL;          // Loaded by LoadMusicStreamed(), NULL for memory music
+static AudioStream stream = { 0 };
+static int channels = 0;
+
+static short *ringSamples = NULL;               // Interleaved, ringFrames*channels
+static int ringFrames = 0;                      // Power of two
+static volatile int ringWrite = 0;              // Frames decoded since start, streaming thread
+static volatile int ringRead = 0;               // Frames played since start, audio callback
+
+static Thread *streamThread = NULL;
+static volatile int streamRunning = 0;
+
+static volatile int underruns = 0;
+static volatile int decodedChunks = 0;
+static volatile int decodeTotalUs = 0;
+static volatile int decodeMaxUs = 0;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static int DecodeMusicChunk(void);              // Returns frames decoded, 0 if ring is full
+static int MusicStreamThread(void *arg);
+static void MusicStreamCallback(void *bufferData, unsigned int frames);
+
+//----------------------------------------------------------------------------------
+// Music Stream Functions Definition
+//----------------------------------------------------------------------------------
+bool LoadMusicStreamed(const char *fileName, int bufferFrames)
+{
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(fileName, &dataSize);
+    if (data == NULL) return false;
+
+    if (!LoadMusicStreamedFromMemory(data, dataSize, bufferFrames))
+    {
+        UnloadFileData(data);
+        return false;
+    }
+
+    fileData = data;
+
+    return true;
+}
+
+bool LoadMusicStreamedFromMemory(const unsigned char *data, int dataSize, int bufferFrames)
+{
+    UnloadMusicStreamed();
+
+    vorbis = stb_vorbis_open_memory(data, dataSize, NULL, NULL);
+    if (vorbis == NULL)
+    {
+        TraceLog(LOG_WARNING, "MUSIC: Failed to open OGG data");
+        return false;
+    }
+
+    stb_vorbis_info info = stb_vorbis_get_info(vorbis);
+    channels = (info.channels > 2)? 2 : info.channels;     // Decoder mixes down extra channels
+
+    ringFrames = MUSIC_MIN_BUFFER;
+    while (ringFrames < bufferFrames) ringFrames *= 2;
+
+    ringSamples = (short *)calloc((size_t)ringFrames*channels, sizeof(short));
+    ringWrite = 0;
+    ringRead = 0;
+    underruns = 0;
+    decodedChunks = 0;
+    decodeTotalUs = 0;
+    decodeMaxUs = 0;
+
+    // Ring starts full, so playback does not begin with an underrun
+    while (DecodeMusicChunk() > 0) { }
+
+    stream = LoadAudioStream(info.sample_rate, 16, channels);
+    SetAudioStreamCallback(stream, MusicStreamCallback);
+
+    AtomicStore(&streamRunning, 1);
+    streamThread = StartThread(MusicStreamThread, NULL);
+
+    if (streamThread == NULL)
+    {
+        TraceLog(LOG_WARNING, "MUSIC: Failed to start streaming thread");
+        UnloadMusicStreamed();
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "MUSIC: Streaming %i Hz, %i channels, %i frames buffered", info.sample_rate, channels, ringFrames);
+
+    return true;
+}
+
+void UnloadMusicStreamed(void)
+{
+    AtomicStore(&streamRunning, 0);
+    JoinThread(streamThread);
+    streamThread = NULL;
+
+    // Audio stream goes first, its callback reads the ring
+    if (stream.buffer != NULL) UnloadAudioStream(stream);
+    stream = (AudioStream){ 0 };
+
+    if (vorbis != NULL) stb_vorbis_close(vorbis);
+    vorbis = NULL;
+
+    free(ringSamples);
+    ringSamples = NULL;
+    ringFrames = 0;
+
+    if (fileData != NULL) UnloadFileData(fileData);
+    fileData = NULL;
+}
+
+bool IsMusicStreamedReady(void)
+{
+    return (streamThread != NULL);
+}
+
+void PlayMusicStreamed(void)
+{
+    if (IsMusicStreamedReady()) PlayAudioStream(stream);
+}
+
+void PauseMusicStreamed(void)
+{
+    if (IsMusicStreamedReady()) PauseAudioStream(stream);
+}
+
+void SetMusicStreamedVolume(float volume)
+{
+    if (IsMusicStreamedReady()) SetAudioStreamVolume(stream, volume);
+}
+
+MusicStreamStats GetMusicStreamedStats(void)
+{
+    MusicStreamStats stats = { 0 };
+    int chunks = AtomicLoad(&decodedChunks);
+
+    stats.underruns = AtomicLoad(&underruns);
+    stats.bufferFrames = ringFrames;
+    stats.bufferedFrames = (int)((unsigned int)AtomicLoad(&ringWrite) - (unsigned int)AtomicLoad(&ringRead));
+    stats.decodedChunks = chunks;
+    stats.decodeAvgMs = (chunks > 0)? AtomicLoad(&decodeTotalUs)/1000.0f/chunks : 0.0f;
+    stats.decodeMaxMs = AtomicLoad(&decodeMaxUs)/1000.0f;
+
+    return stats;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Decode into the free part of the ring, up to its end so the decoder writes in place
+// NOTE: Only one thread may decode at a time, loading thread before the streaming thread starts
+static int DecodeMusicChunk(void)
+{
+    int write = ringWrite;
+    int space = ringFrames - (int)((unsigned int)write - (unsigned int)AtomicLoad(&ringRead));
+    int offset = write & (ringFrames - 1);
+    int frames = ringFrames - offset;
+
+    if (frames > space) frames = space;
+    if (frames > MUSIC_DECODE_CHUNK) frames = MUSIC_DECODE_CHUNK;
+    if (frames == 0) return 0;
+
+    unsigned long long start = GetTimestampNs();
+    int decoded = stb_vorbis_get_samples_short_interleaved(vorbis, channels, ringSamples + offset*channels, frames*channels);
+
+    if (decoded == 0)
+    {
+        // End of music, loop from start
+        stb_vorbis_seek_start(vorbis);
+        decoded = stb_vorbis_get_samples_short_interleaved(vorbis, channels, ringSamples + offset*channels, frames*channels);
+        if (decoded == 0) return 0;     // No samples at all
+    }
+
+    int elapsedUs = (int)((GetTimestampNs() - start)/1000);
+
+    AtomicStore(&ringWrite, (int)((unsigned int)write + decoded));
+
+    AtomicAdd(&decodedChunks, 1);
+    AtomicAdd(&decodeTotalUs, elapsedUs);
+    if (elapsedUs > AtomicLoad(&decodeMaxUs)) AtomicStore(&decodeMaxUs, elapsedUs);
+
+    return decoded;
+}
+
+static int MusicStreamThread(void *arg)
+{
+    (void)arg;
+
+    while (AtomicLoad(&streamRunning))
+    {
+        if (DecodeMusicChunk() == 0) SleepThread(MUSIC_STREAM_SLEEP_MS);
+    }
+
+    return 0;
+}
+
+// Runs on the audio device thread, copies ready frames and never waits for the decoder
+static void MusicStreamCallback(void *bufferData, unsigned int frames)
+{
+    short *output = (short *)bufferData;
+    int read = ringRead;
+    int available = (int)((unsigned int)AtomicLoad(&ringWrite) - (unsigned int)read);
+    int count = ((int)frames < available)? (int)frames : available;
+
+    int offset = read & (ringFrames - 1);
+    int first = ringFrames - offset;
+    if (first > count) first = count;
+
+    memcpy(output, ringSamples + offset*channels, (size_t)first*channels*sizeof(short));
+    memcpy(output + first*channels, ringSamples, (size_t)(count - first)*channels*sizeof(short));
+
+    AtomicStore(&ringRead, (int)((unsigned int)read + count));
+
+    if (count < (int)frames)
+    {
+        memset(output + count*channels, 0, (size_t)(frames - count)*channels*sizeof(short));
+        AtomicAdd(&underruns, 1);
+    }
+}
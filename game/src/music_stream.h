@@ -0,0 +1,57 @@
+/**********************************************************************************************
+*
+*   Music Stream - OGG music decoded on its own thread
+*
+*   A streaming thread decodes the music ahead of playback into a ring buffer, the audio
+*   device callback copies from the ring. The game thread does no audio work per frame (no
+*   UpdateMusicStream()), so a frame hitch can not starve the audio device: playback only
+*   underruns if the streaming thread itself falls a whole ring behind.
+*
+*   The ring has a single producer (streaming thread) and a single consumer (audio callback),
+*   neither of them takes a lock. Music loops when it reaches its end.
+*
+*   One music plays at a time, raylib audio callbacks receive no user pointer.
+*
+**********************************************************************************************/
+
+#ifndef MUSIC_STREAM_H
+#define MUSIC_STREAM_H
+
+#include <stdbool.h>        // Required for: bool
+
+#define MUSIC_STREAM_DEFAULT_BUFFER     32768   // Frames decoded ahead, about 0.75 s at 44100 Hz
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct MusicStreamStats {
+    int underruns;              // Audio callbacks that found the ring short, silence was played instead
+    int bufferFrames;           // Ring capacity
+    int bufferedFrames;         // Frames decoded but not played yet
+    int decodedChunks;
+    float decodeAvgMs;          // Per chunk, on the streaming thread
+    float decodeMaxMs;
+} MusicStreamStats;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Music Stream Functions Declaration
+//----------------------------------------------------------------------------------
+bool LoadMusicStreamed(const char *fileName, int bufferFrames);    // Buffer rounded up to a power of two
+bool LoadMusicStreamedFromMemory(const unsigned char *data, int dataSize, int bufferFrames);   // Data must outlive the music
+void UnloadMusicStreamed(void);
+bool IsMusicStreamedReady(void);
+
+void PlayMusicStreamed(void);
+void PauseMusicStreamed(void);
+void SetMusicStreamedVolume(float volume);
+MusicStreamStats GetMusicStreamedStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MUSIC_STREAM_H
@@ -0,0 +1,70 @@
+/**********************************************************************************************
+*
+*   Particle Renderer - Batched particle drawing
+*
+*   See particle_renderer.h for an overview.
+*
+**********************************************************************************************/
+
+#include "particle_renderer.h"
+#include "rlgl.h"
+
+#define PARTICLE_SPRITE_SIZE    32      // Pixels, sprite is scaled to the pool particle size
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static Texture2D particleSprite = { 0 };
+
+//----------------------------------------------------------------------------------
+// Particle Renderer Functions Definition
+//----------------------------------------------------------------------------------
+
+// Bake particle sprite, opaque center fading out to the edge
+void LoadParticleRenderer(void)
+{
+    Image image = GenImageGradientRadial(PARTICLE_SPRITE_SIZE, PARTICLE_SPRITE_SIZE, 0.0f, WHITE, BLANK);
+
+    particleSprite = LoadTextureFromImage(image);
+    SetTextureFilter(particleSprite, TEXTURE_FILTER_BILINEAR);
+    UnloadImage(image);
+}
+
+void UnloadParticleRenderer(void)
+{
+    UnloadTexture(particleSprite);
+    particleSprite.id = 0;
+}
+
+// Push every particle of the pool as a textured quad, batch is only flushed when full
+void DrawParticleBatch(const ParticlePool *pool)
+{
+    if (pool->count <= 0) return;
+
+    Color color = pool->style.color;
+    float r = pool->style.size;
+
+    BeginBlendMode(BLEND_ADDITIVE);
+    rlSetTexture(particleSprite.id);
+    rlBegin(RL_QUADS);
+
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+
+        for (int i = 0; i < pool->count; i++)
+        {
+            rlCheckRenderBatchLimit(4);
+
+            float x = pool->positionX[i];
+            float y = pool->positionY[i];
+
+            rlColor4ub(color.r, color.g, color.b, (unsigned char)(color.a*pool->alpha[i]));
+            rlTexCoord2f(0.0f, 0.0f); rlVertex2f(x - r, y - r);
+            rlTexCoord2f(0.0f, 1.0f); rlVertex2f(x - r, y + r);
+            rlTexCoord2f(1.0f, 1.0f); rlVertex2f(x + r, y + r);
+            rlTexCoord2f(1.0f, 0.0f); rlVertex2f(x + r, y - r);
+        }
+
+    rlEnd();
+    rlSetTexture(0);
+    EndBlendMode();
+}
@@ -0,0 +1,33 @@
+/**********************************************************************************************
+*
+*   Particle Renderer - Batched particle drawing
+*
+*   A soft dot sprite is baked into a texture once at load time, every particle of a pool
+*   is a textured quad pushed into the rlgl render batch, tinted with the pool color and
+*   its own faded alpha. One pool is one batch, blended additively so overlapping sparks
+*   glow instead of covering each other.
+*
+**********************************************************************************************/
+
+#ifndef PARTICLE_RENDERER_H
+#define PARTICLE_RENDERER_H
+
+#include "raylib.h"
+#include "particles.h"
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Particle Renderer Functions Declaration
+//----------------------------------------------------------------------------------
+void LoadParticleRenderer(void);                    // Requires a window (OpenGL context)
+void UnloadParticleRenderer(void);
+void DrawParticleBatch(const ParticlePool *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PARTICLE_RENDERER_H
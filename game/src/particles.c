@@ -0,0 +1,268 @@
+/**********************************************************************************************
+*
+*   Particles - Pooled visual effects
+*
+*   See particles.h for an overview.
+*
+**********************************************************************************************/
+
+#include "particles.h"
+
+#include <math.h>           // Required for: atan2f(), cosf(), sinf(), expf()
+#include <stdlib.h>         // Required for: malloc(), free()
+
+#if !defined(PARTICLES_NO_SIMD) && defined(__AVX__)
+    #define PARTICLES_SIMD_AVX
+    #include <immintrin.h>
+#elif !defined(PARTICLES_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+    #define PARTICLES_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+#define PARTICLE_MIN_LIFE   0.001f      // Seconds, keeps 1/life finite
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static float GetRandomUnit(unsigned int *state);   // [0, 1)
+
+//----------------------------------------------------------------------------------
+// Particles Functions Definition
+//----------------------------------------------------------------------------------
+ParticlePool LoadParticlePool(ParticleStyle style, int capacity)
+{
+    ParticlePool pool = { 0 };
+
+    pool.style = style;
+    pool.capacity = (capacity > 0)? capacity : 0;
+    pool.random = 2463534242u;
+
+    if (pool.capacity > 0)
+    {
+        pool.positionX = (float *)malloc(pool.capacity*sizeof(float));
+        pool.positionY = (float *)malloc(pool.capacity*sizeof(float));
+        pool.velocityX = (float *)malloc(pool.capacity*sizeof(float));
+        pool.velocityY = (float *)malloc(pool.capacity*sizeof(float));
+        pool.life = (float *)malloc(pool.capacity*sizeof(float));
+        pool.inverseLife = (float *)malloc(pool.capacity*sizeof(float));
+        pool.alpha = (float *)malloc(pool.capacity*sizeof(float));
+        pool.expired = (int *)malloc(pool.capacity*sizeof(int));
+
+        if ((pool.positionX == NULL) || (pool.positionY == NULL) || (pool.velocityX == NULL) || (pool.velocityY == NULL) ||
+            (pool.life == NULL) || (pool.inverseLife == NULL) || (pool.alpha == NULL) || (pool.expired == NULL))
+        {
+            UnloadParticlePool(&pool);
+        }
+    }
+
+    return pool;
+}
+
+void UnloadParticlePool(ParticlePool *pool)
+{
+    free(pool->positionX);
+    free(pool->positionY);
+    free(pool->velocityX);
+    free(pool->velocityY);
+    free(pool->life);
+    free(pool->inverseLife);
+    free(pool->alpha);
+    free(pool->expired);
+
+    ParticleStyle style = pool->style;
+    *pool = (ParticlePool){ 0 };
+    pool->style = style;
+}
+
+void ClearParticles(ParticlePool *pool)
+{
+    pool->count = 0;
+}
+
+// Burst directions are spread evenly around direction, jittered, with random speed and life
+int EmitParticles(ParticlePool *pool, Vector2 position, Vector2 direction)
+{
+    const ParticleStyle *style = &pool->style;
+    int spawned = style->burst;
+
+    if (spawned > pool->capacity - pool->count) spawned = pool->capacity - pool->count;
+    pool->droppedSpawns += style->burst - spawned;
+
+    float baseAngle = ((direction.x != 0.0f) || (direction.y != 0.0f))? atan2f(direction.y, direction.x) : 0.0f;
+    float step = (style->burst > 0)? style->spread/style->burst : 0.0f;
+    float firstAngle = baseAngle - style->spread/2.0f;
+
+    for (int p = 0; p < spawned; p++)
+    {
+        int i = pool->count++;
+        float angle = firstAngle + (p + GetRandomUnit(&pool->random))*step;
+        float speed = style->speedMin + (style->speedMax - style->speedMin)*GetRandomUnit(&pool->random);
+        float life = style->lifeMin + (style->lifeMax - style->lifeMin)*GetRandomUnit(&pool->random);
+
+        if (life < PARTICLE_MIN_LIFE) life = PARTICLE_MIN_LIFE;
+
+        pool->positionX[i] = position.x;
+        pool->positionY[i] = position.y;
+        pool->velocityX[i] = cosf(angle)*speed;
+        pool->velocityY[i] = sinf(angle)*speed;
+        pool->life[i] = life;
+        pool->inverseLife[i] = 1.0f/life;
+        pool->alpha[i] = 1.0f;
+    }
+
+    return spawned;
+}
+
+// Expired particles are removed highest index first, the last particle filling each hole is
+// always alive: every expired one after the hole was removed already
+void UpdateParticles(ParticlePool *pool, float dt)
+{
+    float damping = expf(-pool->style.drag*dt);
+    int expiredCount = MoveParticles(pool->positionX, pool->positionY, pool->velocityX, pool->velocityY, pool->life,
+                                     pool->inverseLife, pool->alpha, pool->count, dt, damping, pool->expired);
+
+    for (int e = expiredCount - 1; e >= 0; e--)
+    {
+        int i = pool->expired[e];
+        int last = --pool->count;
+
+        if (i == last) continue;
+
+        pool->positionX[i] = pool->positionX[last];
+        pool->positionY[i] = pool->positionY[last];
+        pool->velocityX[i] = pool->velocityX[last];
+        pool->velocityY[i] = pool->velocityY[last];
+        pool->life[i] = pool->life[last];
+        pool->inverseLife[i] = pool->inverseLife[last];
+        pool->alpha[i] = pool->alpha[last];
+    }
+}
+
+size_t GetParticlePoolMemory(const ParticlePool *pool)
+{
+    return (size_t)pool->capacity*(7*sizeof(float) + sizeof(int));
+}
+
+//----------------------------------------------------------------------------------
+// Particle Kernels Definition
+//----------------------------------------------------------------------------------
+
+// Reference kernel, also used for the tail that does not fill a SIMD register
+// NOTE: Operations order matches the SIMD kernels so both give the same results
+int MoveParticlesScalar(float *positionX, float *positionY, float *velocityX, float *velocityY, float *life,
+                        const float *inverseLife, float *alpha, int count, float dt, float damping, int *expired)
+{
+    int expiredCount = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        float vx = velocityX[i]*damping;
+        float vy = velocityY[i]*damping;
+        float left = life[i] - dt;
+
+        velocityX[i] = vx;
+        velocityY[i] = vy;
+        positionX[i] += vx*dt;
+        positionY[i] += vy*dt;
+        life[i] = left;
+        alpha[i] = fmaxf(left, 0.0f)*inverseLife[i];
+
+        if (left <= 0.0f) expired[expiredCount++] = i;
+    }
+
+    return expiredCount;
+}
+
+int MoveParticles(float *positionX, float *positionY, float *velocityX, float *velocityY, float *life,
+                  const float *inverseLife, float *alpha, int count, float dt, float damping, int *expired)
+{
+    int expiredCount = 0;
+    int i = 0;
+
+#if defined(PARTICLES_SIMD_AVX)
+    const __m256 delta = _mm256_set1_ps(dt);
+    const __m256 drag = _mm256_set1_ps(damping);
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 vx = _mm256_mul_ps(_mm256_loadu_ps(velocityX + i), drag);
+        __m256 vy = _mm256_mul_ps(_mm256_loadu_ps(velocityY + i), drag);
+        __m256 left = _mm256_sub_ps(_mm256_loadu_ps(life + i), delta);
+
+        _mm256_storeu_ps(velocityX + i, vx);
+        _mm256_storeu_ps(velocityY + i, vy);
+        _mm256_storeu_ps(positionX + i, _mm256_add_ps(_mm256_loadu_ps(positionX + i), _mm256_mul_ps(vx, delta)));
+        _mm256_storeu_ps(positionY + i, _mm256_add_ps(_mm256_loadu_ps(positionY + i), _mm256_mul_ps(vy, delta)));
+        _mm256_storeu_ps(life + i, left);
+        _mm256_storeu_ps(alpha + i, _mm256_mul_ps(_mm256_max_ps(left, zero), _mm256_loadu_ps(inverseLife + i)));
+
+        // Only walk lanes when some particle expired
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(left, zero, _CMP_LE_OQ));
+        for (int lane = 0; mask != 0; lane++, mask >>= 1)
+        {
+            if (mask & 1) expired[expiredCount++] = i + lane;
+        }
+    }
+#elif defined(PARTICLES_SIMD_SSE2)
+    const __m128 delta = _mm_set1_ps(dt);
+    const __m128 drag = _mm_set1_ps(damping);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 vx = _mm_mul_ps(_mm_loadu_ps(velocityX + i), drag);
+        __m128 vy = _mm_mul_ps(_mm_loadu_ps(velocityY + i), drag);
+        __m128 left = _mm_sub_ps(_mm_loadu_ps(life + i), delta);
+
+        _mm_storeu_ps(velocityX + i, vx);
+        _mm_storeu_ps(velocityY + i, vy);
+        _mm_storeu_ps(positionX + i, _mm_add_ps(_mm_loadu_ps(positionX + i), _mm_mul_ps(vx, delta)));
+        _mm_storeu_ps(positionY + i, _mm_add_ps(_mm_loadu_ps(positionY + i), _mm_mul_ps(vy, delta)));
+        _mm_storeu_ps(life + i, left);
+        _mm_storeu_ps(alpha + i, _mm_mul_ps(_mm_max_ps(left, zero), _mm_loadu_ps(inverseLife + i)));
+
+        // Only walk lanes when some particle expired
+        int mask = _mm_movemask_ps(_mm_cmple_ps(left, zero));
+        for (int lane = 0; mask != 0; lane++, mask >>= 1)
+        {
+            if (mask & 1) expired[expiredCount++] = i + lane;
+        }
+    }
+#endif
+
+    // Remaining particles (all of them without SIMD), indices are offset back to the whole range
+    int tailCount = MoveParticlesScalar(positionX + i, positionY + i, velocityX + i, velocityY + i, life + i,
+                                        inverseLife + i, alpha + i, count - i, dt, damping, expired + expiredCount);
+
+    for (int e = expiredCount; e < expiredCount + tailCount; e++) expired[e] += i;
+
+    return expiredCount + tailCount;
+}
+
+const char *GetParticleKernelName(void)
+{
+#if defined(PARTICLES_SIMD_AVX)
+    return "AVX";
+#elif defined(PARTICLES_SIMD_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Xorshift32, particles only need cheap and repeatable noise
+static float GetRandomUnit(unsigned int *state)
+{
+    unsigned int x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return (x >> 8)*(1.0f/16777216.0f);
+}
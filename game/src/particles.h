@@ -0,0 +1,90 @@
+/**********************************************************************************************
+*
+*   Particles - Pooled visual effects
+*
+*   One pool per effect (muzzle flash, hit sparks...), with the look of its particles given
+*   by a ParticleStyle. A pool has a fixed capacity allocated once, bursts that do not fit
+*   are cut and counted, nothing is allocated while playing.
+*
+*   Storage is a structure of arrays, live particles packed in [0, count): UpdateParticles()
+*   integrates motion, drag and alpha fade several particles per SIMD instruction, collects
+*   the ones whose life ran out, then swap-removes them, O(expired). Alpha is stored so the
+*   renderer (particle_renderer.h) reads plain arrays, one batch per pool.
+*
+*   Particles are cosmetic: they have their own random generator, the gameplay simulation
+*   never reads them, so replays and snapshots do not depend on them.
+*
+*   SIMD path is selected at compile time like MoveBullets(): AVX, SSE2 or scalar. Define
+*   PARTICLES_NO_SIMD to force the scalar path.
+*
+**********************************************************************************************/
+
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include "raylib.h"
+
+#include <stddef.h>         // Required for: size_t
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Look of the particles of a pool
+typedef struct ParticleStyle {
+    int burst;              // Particles per EmitParticles() call
+    float spread;           // Radians around emit direction, 2*PI for every direction
+    float speedMin;         // Pixels per second
+    float speedMax;
+    float lifeMin;          // Seconds
+    float lifeMax;
+    float drag;             // Fraction of velocity lost per second, applied continuously
+    float size;             // Pixels, radius of the drawn sprite
+    Color color;            // Alpha fades from color alpha to zero over a particle life
+} ParticleStyle;
+
+typedef struct ParticlePool {
+    ParticleStyle style;
+    float *positionX;
+    float *positionY;
+    float *velocityX;
+    float *velocityY;
+    float *life;            // Seconds left, expired at zero
+    float *inverseLife;     // 1/life at spawn
+    float *alpha;           // Written by UpdateParticles(), life/life at spawn
+    int *expired;           // Scratch, indices collected during an update
+    int count;
+    int capacity;
+    int droppedSpawns;      // Particles cut because the pool was full
+    unsigned int random;    // Xorshift state
+} ParticlePool;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Particles Functions Declaration
+//----------------------------------------------------------------------------------
+ParticlePool LoadParticlePool(ParticleStyle style, int capacity);  // Every array is allocated here, once
+void UnloadParticlePool(ParticlePool *pool);
+void ClearParticles(ParticlePool *pool);
+int EmitParticles(ParticlePool *pool, Vector2 position, Vector2 direction);    // One burst around direction, returns particles spawned
+void UpdateParticles(ParticlePool *pool, float dt);                 // Move, fade and expire, swap-removes expired particles
+size_t GetParticlePoolMemory(const ParticlePool *pool);
+
+//----------------------------------------------------------------------------------
+// Particle Kernels Declaration
+//----------------------------------------------------------------------------------
+// Integrate particles and write alpha, indices of expired particles go to expired in ascending
+// order, returns their number
+int MoveParticles(float *positionX, float *positionY, float *velocityX, float *velocityY, float *life,
+                  const float *inverseLife, float *alpha, int count, float dt, float damping, int *expired);
+int MoveParticlesScalar(float *positionX, float *positionY, float *velocityX, float *velocityY, float *life,
+                        const float *inverseLife, float *alpha, int count, float dt, float damping, int *expired);
+const char *GetParticleKernelName(void);                            // SIMD path MoveParticles() was built with
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PARTICLES_H
@@ -0,0 +1,321 @@
+/**********************************************************************************************
+*
+*   Patterns - Data driven bullet patterns
+*
+*   See patterns.h for an overview and the file format.
+*
+**********************************************************************************************/
+
+#include "patterns.h"
+
+#include <math.h>           // Required for: cosf(), sinf(), sqrtf(), fmod()
+#include <stdio.h>          // Required for: FILE, fopen(), fread(), fclose(), sscanf()
+#include <stdlib.h>         // Required for: malloc(), free()
+#include <string.h>         // Required for: strcmp(), strchr(), strcpy()
+
+#define PATTERN_LINE_SIZE   256         // Longer lines are cut
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Pattern as written in the file, before compilation
+typedef struct PatternDefinition {
+    char name[PATTERN_NAME_SIZE];
+    int arms;
+    int count;
+    float spread;           // Degrees
+    float speed;
+    float speedStep;
+    float angle;            // Degrees
+    float spin;             // Degrees
+    int aimed;
+    int interval;
+    int burst;
+    int pause;
+} PatternDefinition;
+
+typedef struct PatternParser {
+    BulletPatterns *patterns;
+    PatternDefinition definitions[MAX_BULLET_PATTERNS];
+    int definitionCount;
+    char emitterNames[MAX_PATTERN_EMITTERS][PATTERN_NAME_SIZE];     // Resolved once every pattern is read
+    int emitterLines[MAX_PATTERN_EMITTERS];
+} PatternParser;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static bool ParsePatternLine(PatternParser *parser, const char *line);     // Returns false if line is not valid
+static void CompilePatterns(PatternParser *parser);
+
+//----------------------------------------------------------------------------------
+// Patterns Functions Definition
+//----------------------------------------------------------------------------------
+BulletPatterns LoadBulletPatterns(const char *fileName)
+{
+    BulletPatterns patterns = { 0 };
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return patterns;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *text = (size > 0)? (char *)malloc(size) : NULL;
+
+    if ((text != NULL) && (fread(text, 1, size, file) == (size_t)size)) patterns = LoadBulletPatternsFromMemory(text, (int)size);
+
+    free(text);
+    fclose(file);
+
+    return patterns;
+}
+
+// Parse every line, then compile patterns into tables
+BulletPatterns LoadBulletPatternsFromMemory(const char *text, int size)
+{
+    BulletPatterns patterns = { 0 };
+    PatternParser parser = { 0 };
+    parser.patterns = &patterns;
+
+    int position = 0;
+    int lineNumber = 0;
+
+    while (position < size)
+    {
+        char line[PATTERN_LINE_SIZE] = { 0 };
+        int length = 0;
+        lineNumber++;
+
+        while ((position < size) && (text[position] != '\n'))
+        {
+            if (length < PATTERN_LINE_SIZE - 1) line[length++] = text[position];
+            position++;
+        }
+
+        position++;     // Skip '\n'
+
+        char *comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+
+        if (patterns.emitterCount < MAX_PATTERN_EMITTERS) parser.emitterLines[patterns.emitterCount] = lineNumber;
+
+        if (!ParsePatternLine(&parser, line) && (patterns.errorLine == 0)) patterns.errorLine = lineNumber;
+    }
+
+    CompilePatterns(&parser);
+
+    return patterns;
+}
+
+void UnloadBulletPatterns(BulletPatterns patterns)
+{
+    free(patterns.directionX);
+    free(patterns.directionY);
+    free(patterns.speed);
+}
+
+int GetBulletPatternIndex(const BulletPatterns *patterns, const char *name)
+{
+    for (int i = 0; i < patterns->patternCount; i++)
+    {
+        if (strcmp(patterns->patterns[i].name, name) == 0) return i;
+    }
+
+    return -1;
+}
+
+// Bursts of volleys every interval ticks, then a pause
+bool IsVolleyTick(const BulletPattern *pattern, int tick)
+{
+    int burstTicks = pattern->burst*pattern->interval;
+    int phase = tick%(burstTicks + pattern->pause);
+
+    return (phase < burstTicks) && ((phase%pattern->interval) == 0);
+}
+
+// Direction the pattern tables are rotated to, one sine and cosine per volley
+Vector2 GetVolleyDirection(const BulletPattern *pattern, int volley, Vector2 origin, Vector2 target)
+{
+    Vector2 base = { 1.0f, 0.0f };
+
+    if (pattern->aimed)
+    {
+        float dx = target.x - origin.x;
+        float dy = target.y - origin.y;
+        float length = sqrtf(dx*dx + dy*dy);
+
+        if (length > 0.0f) base = (Vector2){ dx/length, dy/length };
+    }
+
+    // NOTE: Spin is wrapped in double precision, angle stays exact after many volleys
+    float angle = pattern->angle + (float)fmod((double)volley*pattern->spin, 2.0*PI);
+    float c = cosf(angle);
+    float s = sinf(angle);
+
+    return (Vector2){ base.x*c - base.y*s, base.x*s + base.y*c };
+}
+
+// Rotate table directions by volley direction, same work for every bullet
+void WriteVolleyBullets(const BulletPatterns *patterns, const BulletPattern *pattern, Vector2 direction, Vector2 origin,
+                        int start, int count, float *positionX, float *positionY,
+                        float *directionX, float *directionY, float *speed)
+{
+    const float *tableX = patterns->directionX + pattern->first + start;
+    const float *tableY = patterns->directionY + pattern->first + start;
+    const float *tableSpeed = patterns->speed + pattern->first + start;
+
+    for (int i = 0; i < count; i++)
+    {
+        positionX[i] = origin.x;
+        positionY[i] = origin.y;
+        directionX[i] = tableX[i]*direction.x - tableY[i]*direction.y;
+        directionY[i] = tableX[i]*direction.y + tableY[i]*direction.x;
+        speed[i] = tableSpeed[i];
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static bool ParsePatternLine(PatternParser *parser, const char *line)
+{
+    BulletPatterns *patterns = parser->patterns;
+    char key[PATTERN_NAME_SIZE] = { 0 };
+    char name[PATTERN_NAME_SIZE] = { 0 };
+
+    if (sscanf(line, "%31s", key) != 1) return true;    // Blank line
+
+    if (strcmp(key, "pattern") == 0)
+    {
+        if ((sscanf(line, "%*s %31s", name) != 1) || (parser->definitionCount >= MAX_BULLET_PATTERNS)) return false;
+
+        PatternDefinition *definition = &parser->definitions[parser->definitionCount++];
+        *definition = (PatternDefinition){ 0 };
+        strcpy(definition->name, name);
+        definition->arms = 1;
+        definition->count = 1;
+        definition->speed = 200.0f;
+        definition->angle = 90.0f;
+        definition->interval = 1;
+        definition->burst = 1;
+
+        return true;
+    }
+
+    if (strcmp(key, "emitter") == 0)
+    {
+        Vector2 position = { 0 };
+
+        if ((sscanf(line, "%*s %31s %f %f", name, &position.x, &position.y) != 3) || (patterns->emitterCount >= MAX_PATTERN_EMITTERS)) return false;
+
+        strcpy(parser->emitterNames[patterns->emitterCount], name);
+        patterns->emitters[patterns->emitterCount].position = position;
+        patterns->emitterCount++;
+
+        return true;
+    }
+
+    // Everything else is a key of the last pattern
+    float value = 0.0f;
+    if ((parser->definitionCount == 0) || (sscanf(line, "%*s %f", &value) != 1)) return false;
+
+    PatternDefinition *definition = &parser->definitions[parser->definitionCount - 1];
+
+    if (strcmp(key, "arms") == 0) definition->arms = (int)value;
+    else if (strcmp(key, "count") == 0) definition->count = (int)value;
+    else if (strcmp(key, "spread") == 0) definition->spread = value;
+    else if (strcmp(key, "speed") == 0) definition->speed = value;
+    else if (strcmp(key, "speedStep") == 0) definition->speedStep = value;
+    else if (strcmp(key, "angle") == 0) definition->angle = value;
+    else if (strcmp(key, "spin") == 0) definition->spin = value;
+    else if (strcmp(key, "aimed") == 0) definition->aimed = (int)value;
+    else if (strcmp(key, "interval") == 0) definition->interval = (int)value;
+    else if (strcmp(key, "burst") == 0) definition->burst = (int)value;
+    else if (strcmp(key, "pause") == 0) definition->pause = (int)value;
+    else return false;
+
+    return true;
+}
+
+// Precompute direction and speed of every volley bullet, arm by arm
+static void CompilePatterns(PatternParser *parser)
+{
+    BulletPatterns *patterns = parser->patterns;
+    int bulletCount = 0;
+
+    // Out of range values are clamped, they are not worth dropping the pattern
+    for (int p = 0; p < parser->definitionCount; p++)
+    {
+        PatternDefinition *definition = &parser->definitions[p];
+
+        if (definition->arms < 1) definition->arms = 1;
+        if (definition->arms > MAX_VOLLEY_BULLETS) definition->arms = MAX_VOLLEY_BULLETS;
+        if (definition->count < 1) definition->count = 1;
+        if (definition->arms*definition->count > MAX_VOLLEY_BULLETS) definition->count = MAX_VOLLEY_BULLETS/definition->arms;
+        if (definition->interval < 1) definition->interval = 1;
+        if (definition->burst < 1) definition->burst = 1;
+        if (definition->pause < 0) definition->pause = 0;
+
+        bulletCount += definition->arms*definition->count;
+    }
+
+    if (bulletCount > 0)
+    {
+        patterns->directionX = (float *)malloc(bulletCount*sizeof(float));
+        patterns->directionY = (float *)malloc(bulletCount*sizeof(float));
+        patterns->speed = (float *)malloc(bulletCount*sizeof(float));
+    }
+
+    for (int p = 0; p < parser->definitionCount; p++)
+    {
+        const PatternDefinition *definition = &parser->definitions[p];
+        BulletPattern *pattern = &patterns->patterns[patterns->patternCount++];
+
+        strcpy(pattern->name, definition->name);
+        pattern->first = patterns->bulletCount;
+        pattern->count = definition->arms*definition->count;
+        pattern->angle = definition->angle*DEG2RAD;
+        pattern->spin = definition->spin*DEG2RAD;
+        pattern->aimed = (definition->aimed != 0);
+        pattern->interval = definition->interval;
+        pattern->burst = definition->burst;
+        pattern->pause = definition->pause;
+
+        float armStep = 2.0f*PI/definition->arms;
+        float spreadStep = (definition->count > 1)? definition->spread*DEG2RAD/(definition->count - 1) : 0.0f;
+        float spreadStart = (definition->count > 1)? -definition->spread*DEG2RAD/2.0f : 0.0f;
+
+        for (int a = 0; a < definition->arms; a++)
+        {
+            for (int b = 0; b < definition->count; b++)
+            {
+                float angle = a*armStep + spreadStart + b*spreadStep;
+                int i = patterns->bulletCount++;
+
+                patterns->directionX[i] = cosf(angle);
+                patterns->directionY[i] = sinf(angle);
+                patterns->speed[i] = definition->speed + b*definition->speedStep;
+            }
+        }
+    }
+
+    // Emitters of unknown patterns are dropped
+    int emitterCount = 0;
+    for (int e = 0; e < patterns->emitterCount; e++)
+    {
+        int pattern = GetBulletPatternIndex(patterns, parser->emitterNames[e]);
+
+        if (pattern == -1)
+        {
+            if ((patterns->errorLine == 0) || (parser->emitterLines[e] < patterns->errorLine)) patterns->errorLine = parser->emitterLines[e];
+            continue;
+        }
+
+        patterns->emitters[emitterCount].pattern = pattern;
+        patterns->emitters[emitterCount].position = patterns->emitters[e].position;
+        emitterCount++;
+    }
+
+    patterns->emitterCount = emitterCount;
+}
@@ -0,0 +1,101 @@
+/**********************************************************************************************
+*
+*   Patterns - Data driven bullet patterns
+*
+*   Patterns are read from a text file and compiled into flat tables: every bullet of a
+*   volley gets its direction (relative to the volley direction) and speed precomputed, so
+*   emitting a volley is one rotation per bullet over plain arrays, with no per-bullet
+*   branching or trigonometry. Spirals, fans, rings and aimed bursts are the same pattern
+*   with different parameters.
+*
+*   File format, one key per line, '#' starts a comment:
+*
+*     pattern <name>        Starts a pattern, keys below apply to it
+*       arms <n>            Groups of bullets, evenly spread around the circle (1)
+*       count <n>           Bullets per arm (1)
+*       spread <degrees>    Angle the bullets of an arm are spread over (0)
+*       speed <pixels/s>    Speed of first bullet of an arm (200)
+*       speedStep <pixels/s> Speed added to every next bullet of an arm (0)
+*       angle <degrees>     Volley direction, clockwise from right (90, straight down)
+*       spin <degrees>      Added to volley direction after every volley (0)
+*       aimed <0|1>         Angle is relative to the direction of the target (0)
+*       interval <ticks>    Ticks between volleys of a burst (1)
+*       burst <n>           Volleys per burst (1)
+*       pause <ticks>       Extra ticks after a burst (0)
+*
+*     emitter <pattern> <x> <y>   Emitter placement, as a fraction of the play field
+*
+**********************************************************************************************/
+
+#ifndef PATTERNS_H
+#define PATTERNS_H
+
+#include "raylib.h"
+
+#define MAX_BULLET_PATTERNS     32
+#define MAX_PATTERN_EMITTERS    32
+#define MAX_VOLLEY_BULLETS      1024        // Bullets per volley, arms*count
+#define PATTERN_NAME_SIZE       32          // Pattern name, including terminator
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Compiled pattern, its volley bullets are [first, first + count) in the pattern tables
+typedef struct BulletPattern {
+    char name[PATTERN_NAME_SIZE];
+    int first;
+    int count;
+    float angle;            // Radians
+    float spin;             // Radians per volley
+    bool aimed;
+    int interval;           // Ticks
+    int burst;              // Volleys
+    int pause;              // Ticks
+} BulletPattern;
+
+// Emitter placement, as a fraction of the play field
+typedef struct PatternEmitter {
+    int pattern;
+    Vector2 position;
+} PatternEmitter;
+
+typedef struct BulletPatterns {
+    BulletPattern patterns[MAX_BULLET_PATTERNS];
+    int patternCount;
+    PatternEmitter emitters[MAX_PATTERN_EMITTERS];
+    int emitterCount;
+
+    // Volley bullets of every pattern, one after another
+    float *directionX;      // Unit direction, relative to volley direction
+    float *directionY;
+    float *speed;
+    int bulletCount;
+
+    int errorLine;          // First line that could not be read, 0 if none
+} BulletPatterns;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Patterns Functions Declaration
+//----------------------------------------------------------------------------------
+BulletPatterns LoadBulletPatterns(const char *fileName);                   // Returns no patterns on failure
+BulletPatterns LoadBulletPatternsFromMemory(const char *text, int size);
+void UnloadBulletPatterns(BulletPatterns patterns);
+int GetBulletPatternIndex(const BulletPatterns *patterns, const char *name); // Returns -1 if not found
+
+bool IsVolleyTick(const BulletPattern *pattern, int tick);                   // Tick counted from emitter start
+Vector2 GetVolleyDirection(const BulletPattern *pattern, int volley, Vector2 origin, Vector2 target);
+
+// Write bullets [start, start + count) of a volley, for spawning straight into bullet arrays
+void WriteVolleyBullets(const BulletPatterns *patterns, const BulletPattern *pattern, Vector2 direction, Vector2 origin,
+                        int start, int count, float *positionX, float *positionY,
+                        float *directionX, float *directionY, float *speed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PATTERNS_H
@@ -0,0 +1,251 @@
+/**********************************************************************************************
+*
+*   Profiler - Per-phase frame timings
+*
+*   See profiler.h for an overview.
+*
+*   Scope samples go through a bounded multi-producer ring: a producer claims a position by
+*   advancing ringTail, writes the sample and publishes it by setting the slot sequence.
+*   The single consumer (EndProfileFrame) reads published slots in order and hands them
+*   back to producers by moving their sequence one lap ahead.
+*
+**********************************************************************************************/
+
+#include "profiler.h"
+#include "threads.h"
+#include "timing.h"
+
+#include <stdio.h>          // Required for: FILE, fopen(), fprintf(), fclose()
+#include <stdlib.h>         // Required for: qsort()
+#include <string.h>         // Required for: memset()
+
+#define RING_MASK   (PROFILE_RING_SIZE - 1)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct ProfileSlot {
+    volatile int sequence;          // Position this slot is ready for (write), or position + 1 (read)
+    int phase;
+    unsigned long long duration;    // Nanoseconds
+} ProfileSlot;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static bool profilerReady = false;
+static ProfileSlot ring[PROFILE_RING_SIZE] = { 0 };
+static volatile int ringTail = 0;               // Next position producers claim
+static int ringHead = 0;                        // Next position consumer reads
+static volatile int droppedSamples = 0;
+
+static unsigned long long frameStart = 0;
+static unsigned long long frameTimes[PROFILE_PHASE_COUNT] = { 0 };      // Current frame, nanoseconds
+
+static float history[PROFILE_HISTORY_FRAMES][PROFILE_PHASE_COUNT] = { 0 };  // Milliseconds
+static int historyNext = 0;                     // Slot for next frame
+static int historyCount = 0;
+static unsigned int framesRecorded = 0;         // Frames since InitProfiler(), numbers CSV rows
+
+static const char *phaseNames[PROFILE_PHASE_COUNT] = {
+    "frame", "screen_update", "bullets", "transition", "draw", "swap", "screen_load", "pacing", "input_latency"
+};
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void DrainProfileRing(void);
+static int CompareFloats(const void *a, const void *b);
+
+//----------------------------------------------------------------------------------
+// Profiler Functions Definition
+//----------------------------------------------------------------------------------
+void InitProfiler(void)
+{
+    for (int i = 0; i < PROFILE_RING_SIZE; i++) ring[i].sequence = i;
+
+    ringTail = 0;
+    ringHead = 0;
+    droppedSamples = 0;
+    frameStart = 0;
+    memset(frameTimes, 0, sizeof(frameTimes));
+    historyNext = 0;
+    historyCount = 0;
+    framesRecorded = 0;
+
+    profilerReady = true;
+}
+
+void CloseProfiler(void)
+{
+    profilerReady = false;
+}
+
+bool IsProfilerReady(void)
+{
+    return profilerReady;
+}
+
+void BeginProfileFrame(void)
+{
+    if (!profilerReady) return;
+
+    frameStart = GetTimestampNs();
+}
+
+// Close current frame: collect its samples and push it to history
+void EndProfileFrame(void)
+{
+    if (!profilerReady || (frameStart == 0)) return;
+
+    frameTimes[PROFILE_FRAME] = GetTimestampNs() - frameStart;
+    DrainProfileRing();
+
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++) history[historyNext][p] = frameTimes[p]/1000000.0f;
+
+    historyNext = (historyNext + 1)%PROFILE_HISTORY_FRAMES;
+    if (historyCount < PROFILE_HISTORY_FRAMES) historyCount++;
+    framesRecorded++;
+
+    memset(frameTimes, 0, sizeof(frameTimes));
+    frameStart = 0;
+}
+
+unsigned long long BeginProfileScope(void)
+{
+    return profilerReady? GetTimestampNs() : 0;
+}
+
+// Push scope duration to the ring, safe from any thread
+void EndProfileScope(ProfilePhase phase, unsigned long long start)
+{
+    if (!profilerReady || (start == 0)) return;
+
+    unsigned long long duration = GetTimestampNs() - start;
+    int position = AtomicLoad(&ringTail);
+    ProfileSlot *slot = NULL;
+
+    for (;;)
+    {
+        slot = &ring[position & RING_MASK];
+
+        // NOTE: Positions wrap around, differences are computed unsigned
+        int diff = (int)((unsigned int)AtomicLoad(&slot->sequence) - (unsigned int)position);
+
+        if (diff == 0)
+        {
+            int next = (int)((unsigned int)position + 1);
+            int previous = AtomicCompareExchange(&ringTail, position, next);
+
+            if (previous == position) break;
+            position = previous;
+        }
+        else if (diff < 0)
+        {
+            // Ring full, consumer is a whole lap behind
+            AtomicAdd(&droppedSamples, 1);
+            return;
+        }
+        else position = AtomicLoad(&ringTail);
+    }
+
+    slot->phase = phase;
+    slot->duration = duration;
+    AtomicStore(&slot->sequence, (int)((unsigned int)position + 1));
+}
+
+const char *GetProfilePhaseName(ProfilePhase phase)
+{
+    return phaseNames[phase];
+}
+
+int GetProfileFrameCount(void)
+{
+    return historyCount;
+}
+
+float GetProfileFrameTime(ProfilePhase phase, int framesAgo)
+{
+    if ((framesAgo < 0) || (framesAgo >= historyCount)) return 0.0f;
+
+    int index = (historyNext - 1 - framesAgo + PROFILE_HISTORY_FRAMES)%PROFILE_HISTORY_FRAMES;
+
+    return history[index][phase];
+}
+
+// Sorts a copy of the phase history, O(n log n), meant for once per frame at most
+ProfileStats GetProfileStats(ProfilePhase phase)
+{
+    static float sorted[PROFILE_HISTORY_FRAMES] = { 0 };
+    ProfileStats stats = { 0 };
+
+    if (historyCount == 0) return stats;
+
+    for (int i = 0; i < historyCount; i++) sorted[i] = history[i][phase];
+    qsort(sorted, historyCount, sizeof(float), CompareFloats);
+
+    stats.last = GetProfileFrameTime(phase, 0);
+    stats.p50 = sorted[(int)(0.50f*(historyCount - 1) + 0.5f)];
+    stats.p99 = sorted[(int)(0.99f*(historyCount - 1) + 0.5f)];
+    stats.max = sorted[historyCount - 1];
+
+    return stats;
+}
+
+int GetProfileDroppedSamples(void)
+{
+    return AtomicLoad(&droppedSamples);
+}
+
+bool SaveProfilerCSV(const char *fileName)
+{
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) return false;
+
+    fprintf(file, "frame");
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++) fprintf(file, ",%s_ms", phaseNames[p]);
+    fprintf(file, "\n");
+
+    unsigned int firstFrame = framesRecorded - historyCount;
+
+    for (int i = 0; i < historyCount; i++)
+    {
+        int index = (historyNext - historyCount + i + PROFILE_HISTORY_FRAMES)%PROFILE_HISTORY_FRAMES;
+
+        fprintf(file, "%u", firstFrame + i);
+        for (int p = 0; p < PROFILE_PHASE_COUNT; p++) fprintf(file, ",%.4f", history[index][p]);
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Add every published sample to current frame, slots go back to producers
+static void DrainProfileRing(void)
+{
+    for (;;)
+    {
+        ProfileSlot *slot = &ring[ringHead & RING_MASK];
+        int next = (int)((unsigned int)ringHead + 1);
+
+        if (AtomicLoad(&slot->sequence) != next) break;     // Not published yet
+
+        frameTimes[slot->phase] += slot->duration;
+        AtomicStore(&slot->sequence, (int)((unsigned int)ringHead + PROFILE_RING_SIZE));
+        ringHead = next;
+    }
+}
+
+static int CompareFloats(const void *a, const void *b)
+{
+    float fa = *(const float *)a;
+    float fb = *(const float *)b;
+
+    return (fa > fb) - (fa < fb);
+}
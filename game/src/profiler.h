@@ -0,0 +1,84 @@
+/**********************************************************************************************
+*
+*   Profiler - Per-phase frame timings
+*
+*   Hot paths are wrapped in scoped timers, every scope pushes its duration into a lock-free
+*   ring buffer (any thread may push, no lock is taken). EndProfileFrame() drains the ring on
+*   the main thread and adds the durations to the frame history, so a phase entered several
+*   times in a frame (one bullets update per tick) reports its total for that frame.
+*
+*   History keeps the last PROFILE_HISTORY_FRAMES frames, it feeds the overlay (frame time
+*   graph, p50/p99/max per phase) and is written to CSV by SaveProfilerCSV().
+*
+*   Until InitProfiler() is called scopes cost one branch and record nothing, so modules
+*   shared with headless tools (shooter_bench) can stay instrumented.
+*
+**********************************************************************************************/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>        // Required for: bool
+
+#define PROFILE_HISTORY_FRAMES  4096    // Frames kept for stats and CSV export
+#define PROFILE_RING_SIZE       1024    // Scope samples between two EndProfileFrame(), power of two
+
+// Time a block of code, the block must be left by its end (no break/return/goto out of it)
+#define PROFILE_SCOPE(phase) \
+    for (unsigned long long profileStart_ = BeginProfileScope(), profileDone_ = 0; !profileDone_; profileDone_ = 1, EndProfileScope(phase, profileStart_))
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum ProfilePhase {
+    PROFILE_FRAME = 0,          // Whole frame, BeginProfileFrame() to EndProfileFrame()
+    PROFILE_SCREEN_UPDATE,      // Update*Screen() calls, per frame and per tick
+    PROFILE_BULLETS,            // Bullets update, collisions and compaction (inside screen update)
+    PROFILE_TRANSITION,         // Screen transition update and draw, including Unload/Init*Screen()
+    PROFILE_DRAW,               // Draw*Screen() calls
+    PROFILE_SWAP,               // EndDrawing(), batch flush, buffer swap and vsync wait
+    PROFILE_SCREEN_LOAD,        // Load*Screen() on the loader thread, counted in the frame it ends
+    PROFILE_PACING,             // Frame pacer sleep and spin, before the frame starts
+    PROFILE_INPUT_LATENCY,      // Input sample the frame is drawn with to end of EndDrawing(), not a share of the frame
+    PROFILE_PHASE_COUNT
+} ProfilePhase;
+
+// Phase timings over the frame history, in milliseconds
+typedef struct ProfileStats {
+    float last;
+    float p50;
+    float p99;
+    float max;
+} ProfileStats;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Profiler Functions Declaration
+//----------------------------------------------------------------------------------
+void InitProfiler(void);                                    // Start recording, clears history
+void CloseProfiler(void);                                   // Stop recording, history is kept for export
+bool IsProfilerReady(void);
+
+void BeginProfileFrame(void);
+void EndProfileFrame(void);                                 // Collect scope samples, main thread only
+unsigned long long BeginProfileScope(void);                 // Returns scope start timestamp
+void EndProfileScope(ProfilePhase phase, unsigned long long start);
+
+const char *GetProfilePhaseName(ProfilePhase phase);
+int GetProfileFrameCount(void);                             // Frames in history
+float GetProfileFrameTime(ProfilePhase phase, int framesAgo);   // Milliseconds, 0 is last frame
+ProfileStats GetProfileStats(ProfilePhase phase);
+int GetProfileDroppedSamples(void);                         // Samples lost because ring was full
+bool SaveProfilerCSV(const char *fileName);                 // One row per frame in history, oldest first
+
+// Overlay with frame time graph and stats per phase, requires a window (profiler_overlay.c)
+void DrawProfilerOverlay(int posX, int posY);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROFILER_H
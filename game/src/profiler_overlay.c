@@ -0,0 +1,67 @@
+/**********************************************************************************************
+*
+*   Profiler Overlay - Frame time graph and per-phase stats
+*
+*   Kept apart from profiler.c so the profiler core does not need a window, see profiler.h.
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+#include "profiler.h"
+
+#define OVERLAY_WIDTH           300
+#define OVERLAY_GRAPH_FRAMES    240                 // Frames shown in graph, one pixel column each
+#define OVERLAY_GRAPH_HEIGHT    60
+#define OVERLAY_GRAPH_MS        (1000.0f/30.0f)     // Graph top, 30 fps frame time
+#define OVERLAY_LINE_HEIGHT     12
+#define OVERLAY_NAME_WIDTH      90
+#define OVERLAY_COLUMN_WIDTH    48
+
+//----------------------------------------------------------------------------------
+// Profiler Overlay Functions Definition
+//----------------------------------------------------------------------------------
+void DrawProfilerOverlay(int posX, int posY)
+{
+    int height = 8 + OVERLAY_GRAPH_HEIGHT + 8 + OVERLAY_LINE_HEIGHT*(PROFILE_PHASE_COUNT + 1) + 4;
+
+    DrawRectangle(posX, posY, OVERLAY_WIDTH, height, Fade(BLACK, 0.75f));
+
+    // Frame time graph, newest frame on the right
+    int graphX = posX + 8;
+    int graphY = posY + 8;
+    int frames = GetProfileFrameCount();
+    if (frames > OVERLAY_GRAPH_FRAMES) frames = OVERLAY_GRAPH_FRAMES;
+
+    for (int i = 0; i < frames; i++)
+    {
+        float ms = GetProfileFrameTime(PROFILE_FRAME, i);
+        int barHeight = (int)(ms/OVERLAY_GRAPH_MS*OVERLAY_GRAPH_HEIGHT);
+        if (barHeight > OVERLAY_GRAPH_HEIGHT) barHeight = OVERLAY_GRAPH_HEIGHT;
+
+        Color color = (ms > 1000.0f/60.0f)? ORANGE : LIME;
+        DrawRectangle(graphX + OVERLAY_GRAPH_FRAMES - 1 - i, graphY + OVERLAY_GRAPH_HEIGHT - barHeight, 1, barHeight, color);
+    }
+
+    // 60 fps frame budget line
+    int budgetY = graphY + OVERLAY_GRAPH_HEIGHT - (int)(1000.0f/60.0f/OVERLAY_GRAPH_MS*OVERLAY_GRAPH_HEIGHT);
+    DrawLine(graphX, budgetY, graphX + OVERLAY_GRAPH_FRAMES, budgetY, Fade(RAYWHITE, 0.5f));
+    DrawText("16.7", graphX + OVERLAY_GRAPH_FRAMES + 4, budgetY - 4, 10, RAYWHITE);
+
+    // Stats table, milliseconds over the whole history
+    // NOTE: Default font is not monospaced, every column is drawn at its own position
+    int textY = graphY + OVERLAY_GRAPH_HEIGHT + 8;
+    const char *headers[4] = { "last", "p50", "p99", "max" };
+
+    DrawText("ms", graphX, textY, 10, GRAY);
+    for (int c = 0; c < 4; c++) DrawText(headers[c], graphX + OVERLAY_NAME_WIDTH + c*OVERLAY_COLUMN_WIDTH, textY, 10, GRAY);
+
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++)
+    {
+        ProfileStats stats = GetProfileStats((ProfilePhase)p);
+        float values[4] = { stats.last, stats.p50, stats.p99, stats.max };
+
+        textY += OVERLAY_LINE_HEIGHT;
+        DrawText(GetProfilePhaseName((ProfilePhase)p), graphX, textY, 10, RAYWHITE);
+        for (int c = 0; c < 4; c++) DrawText(TextFormat("%.2f", values[c]), graphX + OVERLAY_NAME_WIDTH + c*OVERLAY_COLUMN_WIDTH, textY, 10, RAYWHITE);
+    }
+}
@@ -14,19 +14,54 @@
 
 #include "raylib.h"
 #include "screens.h"    // NOTE: Declares global (extern) variables and screens functions
+#include "jobs.h"
+#include "profiler.h"
+#include "bundle.h"
+#include "frame_pacer.h"
+#include "music_stream.h"
+#include "sfx.h"
+#include "threads.h"
+#include "timing.h"
 
 #if defined(PLATFORM_WEB)
     #include <emscripten/emscripten.h>
 #endif
 
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SCREEN_COUNT            (ENDING + 1)
+#define SCREEN_CACHE_BUDGET     (32*1024*1024)      // Bytes left screens may keep resident
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Screen registry entry, hooks a screen does not need are NULL
+typedef struct ScreenEntry {
+    const char *name;
+    void (*load)(void);             // CPU side loading, runs on the loader thread before init
+    void (*init)(void);
+    void (*resume)(void);           // Enter again while resident, NULL unloads the screen when left
+    void (*frameUpdate)(void);      // Once per frame, menus and input sampling
+    bool (*lateSample)(void);       // Input polled and sampled again right before draw (--late-input), false if it was not polled, NULL if not needed
+    void (*tickUpdate)(void);       // Once per fixed tick, simulation
+    void (*draw)(void);
+    void (*unload)(void);
+    int (*finish)(void);            // Non zero when done, picks the next screen
+    size_t (*memory)(void);         // Bytes held while resident, heap and render textures, NULL if negligible
+    GameScreen next[2];             // Next screen for finish values 1 and 2
+} ScreenEntry;
+
 //----------------------------------------------------------------------------------
 // Shared Variables Definition (global)
 // NOTE: Those variables are shared between modules through screens.h
 //----------------------------------------------------------------------------------
 GameScreen currentScreen = LOGO;
 Font font = { 0 };
-Music music = { 0 };
 Sound fxCoin = { 0 };
+int sfxShot = -1;
+BulletPatterns patterns = { 0 };
+float tickAlpha = 0.0f;
 
 //----------------------------------------------------------------------------------
 // Local Variables Definition (local to this module)
@@ -41,6 +76,40 @@ static bool transFadeOut = false;
 static int transFromScreen = -1;
 static GameScreen transToScreen = UNKNOWN;
 
+// Fixed timestep: frame time not simulated yet
+static float tickAccumulator = 0.0f;
+
+static bool showProfiler = false;           // Toggled with F3
+
+// Frame rate limit, measures frame jitter even when frames are paced by vsync
+static FramePacer framePacer = { 0 };
+
+// Late input: polled again right before draw, frame start optionally delayed after the swap
+static bool lateInput = false;
+static unsigned long long inputSampleTime = 0;  // Input the current frame draws with, profiler timestamp
+
+static Bundle assets = { 0 };               // Packed resources, mapped until exit
+
+// Every screen, indexed by GameScreen
+static const ScreenEntry screenTable[SCREEN_COUNT] = {
+    [LOGO] = { "LOGO", NULL, InitLogoScreen, NULL, NULL, NULL, UpdateLogoScreen, DrawLogoScreen, UnloadLogoScreen, FinishLogoScreen, NULL, { TITLE, TITLE } },
+    [TITLE] = { "TITLE", NULL, InitTitleScreen, ResumeTitleScreen, UpdateTitleScreen, NULL, NULL, DrawTitleScreen, UnloadTitleScreen, FinishTitleScreen, GetTitleScreenMemory, { OPTIONS, GAMEPLAY } },
+    [OPTIONS] = { "OPTIONS", NULL, InitOptionsScreen, ResumeOptionsScreen, UpdateOptionsScreen, NULL, NULL, DrawOptionsScreen, UnloadOptionsScreen, FinishOptionsScreen, NULL, { TITLE, TITLE } },
+    [GAMEPLAY] = { "GAMEPLAY", LoadGameplayScreen, InitGameplayScreen, ResumeGameplayScreen, SampleGameplayInput, LatchGameplayInput, UpdateGameplayScreen, DrawGameplayScreen, UnloadGameplayScreen, FinishGameplayScreen, GetGameplayScreenMemory, { ENDING, TITLE } },
+    [ENDING] = { "ENDING", NULL, InitEndingScreen, ResumeEndingScreen, UpdateEndingScreen, NULL, NULL, DrawEndingScreen, UnloadEndingScreen, FinishEndingScreen, GetEndingScreenMemory, { TITLE, TITLE } },
+};
+
+// Screens left with their data kept, entering them again only calls resume
+// NOTE: Least recently used ones are unloaded when the cache goes over SCREEN_CACHE_BUDGET
+static bool screenResident[SCREEN_COUNT] = { 0 };
+static unsigned int screenLastUsed[SCREEN_COUNT] = { 0 };
+static unsigned int screenClock = 0;
+
+// Next screen loading, runs on its own thread while the transition fades in
+static Thread *loadThread = NULL;
+static volatile int loadFinished = 0;
+static GameScreen loadScreen = UNKNOWN;
+
 //----------------------------------------------------------------------------------
 // Local Functions Declaration
 //----------------------------------------------------------------------------------
@@ -49,70 +118,162 @@ static void ChangeToScreen(int screen);     // Change to screen, no transition e
 static void TransitionToScreen(int screen); // Request transition to next screen
 static void UpdateTransition(void);         // Update transition effect
 static void DrawTransition(void);           // Draw transition effect (full-screen rectangle)
-
+static void LoadScreen(GameScreen screen);  // Load screen data, CPU side only, any thread
+static void StartScreenLoad(GameScreen screen); // Load screen data on the loader thread
+static int ScreenLoadThread(void *arg);     // Loader thread entry point
+static void LeaveScreen(GameScreen screen); // Keep screen resident or unload it
+static void EnterScreen(GameScreen screen); // Resume resident screen or init it, becomes current
+static void EvictScreens(void);             // Unload least recently used screens over budget
+static void CheckScreenFinish(void);        // Start transition when current screen is done
+
+static void UpdateTick(void);               // Update one fixed simulation tick
 static void UpdateDrawFrame(void);          // Update and draw one frame
 
 //----------------------------------------------------------------------------------
 // Main entry point
 //----------------------------------------------------------------------------------
-int main(void)
+int main(int argc, char *argv[])
 {
     // Initialization
     //---------------------------------------------------------
+    // Command line: --record <file> saves gameplay input, --replay <file> plays it back
+    // and quits when done, so a recorded session can be timed against every build;
+    // --music-buffer <frames> sets how far ahead music is decoded;
+    // --fps <rate> paces frames at rate instead of vsync, 0 for uncapped;
+    // --late-input <us> samples input again right before draw, frames start us after the last one
+    bool replaying = false;
+    int musicBufferFrames = MUSIC_STREAM_DEFAULT_BUFFER;
+    int targetFps = -1;
+    int frameDelay = 0;
+
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (TextIsEqual(argv[i], "--record")) SetGameplayRecording(argv[++i]);
+        else if (TextIsEqual(argv[i], "--replay"))
+        {
+            SetGameplayReplay(argv[++i]);
+            replaying = true;
+        }
+        else if (TextIsEqual(argv[i], "--music-buffer")) musicBufferFrames = TextToInteger(argv[++i]);
+        else if (TextIsEqual(argv[i], "--fps")) targetFps = TextToInteger(argv[++i]);
+        else if (TextIsEqual(argv[i], "--late-input"))
+        {
+            frameDelay = TextToInteger(argv[++i]);
+            lateInput = true;
+        }
+    }
+
+    // Render rate is not tied to simulation, sync to display unless a rate is given
+    // NOTE: Browser paces frames itself, pacer only measures there
+    if (targetFps < 0) SetConfigFlags(FLAG_VSYNC_HINT);
+#if defined(PLATFORM_WEB)
+    targetFps = -1;
+#endif
+    framePacer = LoadFramePacer((targetFps > 0)? targetFps : 0);
+    SetFramePacerDelay(&framePacer, frameDelay);
     InitWindow(screenWidth, screenHeight, "raylib game template");
 
     InitAudioDevice();      // Initialize audio device
+    InitJobSystem(0);       // Worker threads for entity updates, one per core
+    InitProfiler();         // Frame phase timings, overlay on F3
     DisableCursor();
     // Load global data (assets that must be available in all screens, i.e. font)
-    font = LoadFont("resources/mecha.png");
-    //music = LoadMusicStream("resources/ambient.ogg");
-    fxCoin = LoadSound("resources/coin.wav");
+    // NOTE: Bundle is built by shooter_packer after every game build, loose files are
+    // only a fallback for running without it
+    assets = LoadBundle("resources/assets.pak");
 
-    //SetMusicVolume(music, 1.0f);
-    //PlayMusicStream(music);
-
-    // Setup and init first screen
-    currentScreen = GAMEPLAY;
-    switch (currentScreen)
+    if (IsBundleReady(assets))
     {
-        case LOGO: InitLogoScreen(); break;
-        case TITLE: InitTitleScreen(); break;
-        case GAMEPLAY: InitGameplayScreen(); break;
-        case ENDING: InitEndingScreen(); break;
-        default: break;
+        font = LoadFontFromImage(GetBundleImage(assets, "mecha.png"), MAGENTA, 32);
+        int musicSize = 0;
+        const unsigned char *musicData = GetBundleData(assets, "ambient.ogg", &musicSize);
+        if (musicData != NULL) LoadMusicStreamedFromMemory(musicData, musicSize, musicBufferFrames);
+        fxCoin = LoadSoundFromWave(GetBundleWave(assets, "coin.wav"));
+        int patternsSize = 0;
+        const unsigned char *patternsData = GetBundleData(assets, "patterns.txt", &patternsSize);
+        if (patternsData != NULL) patterns = LoadBulletPatternsFromMemory((const char *)patternsData, patternsSize);
     }
-    
+    else
+    {
+        font = LoadFont("resources/mecha.png");
+        LoadMusicStreamed("resources/ambient.ogg", musicBufferFrames);
+        fxCoin = LoadSound("resources/coin.wav");
+        patterns = LoadBulletPatterns("resources/patterns.txt");
+    }
+
+    if (patterns.errorLine != 0) TraceLog(LOG_WARNING, "PATTERNS: Line %i could not be read", patterns.errorLine);
+
+    // Rapid sounds go through the voice pool, a few voices whatever the fire rate
+    InitSfx((float)screenWidth);
+    sfxShot = LoadSfx(fxCoin, 4, 0);
+
+    // NOTE: Music is decoded on its own thread, nothing to update per frame
+    SetMusicStreamedVolume(1.0f);
+    PlayMusicStreamed();
+
+    // Setup and init first screen
+    LoadScreen(GAMEPLAY);
+    EnterScreen(GAMEPLAY);
 
 #if defined(PLATFORM_WEB)
-    emscripten_set_main_loop(UpdateDrawFrame, 60, 1);
+    emscripten_set_main_loop(UpdateDrawFrame, 0, 1);
 #else
-    SetTargetFPS(60);       // Set our game to run at 60 frames-per-second
+    // NOTE: No target FPS, simulation runs at TICK_RATE whatever the render rate is
     //--------------------------------------------------------------------------------------
 
     // Main game loop
     while (!WindowShouldClose())    // Detect window close button or ESC key
     {
+        if (replaying && IsGameplayReplayFinished()) break;
+
         UpdateDrawFrame();
     }
 #endif
 
     // De-Initialization
     //--------------------------------------------------------------------------------------
-    // Unload current screen data before closing
-    switch (currentScreen)
+    // Window closed during a transition, let the loader thread finish first
+    JoinThread(loadThread);
+
+    // Unload current and resident screens data before closing
+    for (int i = 0; i < SCREEN_COUNT; i++)
     {
-        case LOGO: UnloadLogoScreen(); break;
-        case TITLE: UnloadTitleScreen(); break;
-        case GAMEPLAY: UnloadGameplayScreen(); break;
-        case ENDING: UnloadEndingScreen(); break;
-        default: break;
+        if (screenResident[i]) screenTable[i].unload();
     }
 
     // Unload global data loaded
     UnloadFont(font);
-    //UnloadMusicStream(music);
+    MusicStreamStats musicStats = GetMusicStreamedStats();
+    if (IsMusicStreamedReady()) TraceLog(LOG_INFO, "MUSIC: %i underruns, decode %.3f ms avg, %.3f ms max per chunk", musicStats.underruns, musicStats.decodeAvgMs, musicStats.decodeMaxMs);
+    UnloadMusicStreamed();
+    CloseSfx();             // Before fxCoin, voices share its samples
     UnloadSound(fxCoin);
+    UnloadBulletPatterns(patterns);
+    UnloadBundle(assets);   // After music, it streams from the mapping
+
+    // Frame interval error against the target rate, or against the previous frame without one
+    TraceLog(LOG_INFO, "PACER: %i frames, %i missed, max jitter %.3f ms, slept %.1f s, spun %.1f s", framePacer.frames, framePacer.missed,
+             framePacer.maxError/1e6, framePacer.sleptNs/1e9, framePacer.spunNs/1e9);
+
+    for (int i = 0; i < FRAME_PACER_BUCKETS; i++)
+    {
+        int limit = GetFramePacerBucketLimit(i);
+
+        if (limit != -1) TraceLog(LOG_INFO, "PACER:   <= %4i us: %i frames", limit, framePacer.histogram[i]);
+        else TraceLog(LOG_INFO, "PACER:    > %4i us: %i frames", GetFramePacerBucketLimit(i - 1), framePacer.histogram[i]);
+    }
+
+    UnloadFramePacer(&framePacer);
+
+    ProfileStats latency = GetProfileStats(PROFILE_INPUT_LATENCY);
+    TraceLog(LOG_INFO, "INPUT: Sample to present %.2f ms p50, %.2f ms p99 (%s)", latency.p50, latency.p99, lateInput? "latched before draw" : "polled at swap");
+
+    // Keep timings of the session, to compare builds
+    CloseProfiler();
+    if (SaveProfilerCSV("profile.csv")) TraceLog(LOG_INFO, "PROFILER: Frame timings saved to profile.csv");
+    else TraceLog(LOG_WARNING, "PROFILER: Failed to save frame timings");
 
+    CloseJobSystem();       // Stop worker threads
     CloseAudioDevice();     // Close audio context
 
     CloseWindow();          // Close window and OpenGL context
@@ -127,27 +288,10 @@ int main(void)
 // Change to next screen, no transition
 static void ChangeToScreen(GameScreen screen)
 {
-    // Unload current screen
-    switch (currentScreen)
-    {
-        case LOGO: UnloadLogoScreen(); break;
-        case TITLE: UnloadTitleScreen(); break;
-        case GAMEPLAY: UnloadGameplayScreen(); break;
-        case ENDING: UnloadEndingScreen(); break;
-        default: break;
-    }
-
-    // Init next screen
-    switch (screen)
-    {
-        case LOGO: InitLogoScreen(); break;
-        case TITLE: InitTitleScreen(); break;
-        case GAMEPLAY: InitGameplayScreen(); break;
-        case ENDING: InitEndingScreen(); break;
-        default: break;
-    }
+    LeaveScreen(currentScreen);
 
-    currentScreen = screen;
+    if (!screenResident[screen]) LoadScreen(screen);
+    EnterScreen(screen);
 }
 
 // Request transition to next screen
@@ -158,6 +302,8 @@ static void TransitionToScreen(GameScreen screen)
     transFromScreen = currentScreen;
     transToScreen = screen;
     transAlpha = 0.0f;
+
+    StartScreenLoad(screen);
 }
 
 // Update transition effect (fade-in, fade-out)
@@ -169,32 +315,17 @@ static void UpdateTransition(void)
 
         // NOTE: Due to float internal representation, condition jumps on 1.0f instead of 1.05f
         // For that reason we compare against 1.01f, to avoid last frame loading stop
-        if (transAlpha > 1.01f)
+        // Screen is fully covered, it stays so until next screen data is loaded
+        if ((transAlpha > 1.01f) && AtomicLoad(&loadFinished))
         {
             transAlpha = 1.0f;
 
-            // Unload current screen
-            switch (transFromScreen)
-            {
-                case LOGO: UnloadLogoScreen(); break;
-                case TITLE: UnloadTitleScreen(); break;
-                case OPTIONS: UnloadOptionsScreen(); break;
-                case GAMEPLAY: UnloadGameplayScreen(); break;
-                case ENDING: UnloadEndingScreen(); break;
-                default: break;
-            }
-
-            // Load next screen
-            switch (transToScreen)
-            {
-                case LOGO: InitLogoScreen(); break;
-                case TITLE: InitTitleScreen(); break;
-                case GAMEPLAY: InitGameplayScreen(); break;
-                case ENDING: InitEndingScreen(); break;
-                default: break;
-            }
-
-            currentScreen = transToScreen;
+            JoinThread(loadThread);
+            loadThread = NULL;
+
+            // Next screen data is already loaded, or was kept resident
+            LeaveScreen(transFromScreen);
+            EnterScreen(transToScreen);
 
             // Activate fade out effect to next loaded screen
             transFadeOut = true;
@@ -221,58 +352,193 @@ static void DrawTransition(void)
     DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(BLACK, transAlpha));
 }
 
-// Update and draw game frame
-static void UpdateDrawFrame(void)
+// Load screen data that does not need the main thread (files, decoding, allocations),
+// GPU and audio resources are created afterwards by Init*Screen() on the main thread
+static void LoadScreen(GameScreen screen)
 {
-    // Update
-    //----------------------------------------------------------------------------------
-    //UpdateMusicStream(music);       // NOTE: Music keeps playing between screens
+    unsigned long long start = GetTimestampNs();
+    unsigned long long scopeStart = BeginProfileScope();
+
+    if (screenTable[screen].load != NULL) screenTable[screen].load();
+
+    EndProfileScope(PROFILE_SCREEN_LOAD, scopeStart);
+    TraceLog(LOG_INFO, "SCREEN: [%s] Loaded in %.2f ms", screenTable[screen].name, (GetTimestampNs() - start)/1e6);
+}
+
+static void StartScreenLoad(GameScreen screen)
+{
+    // Resident screen kept its data, transition only waits for the fade
+    if (screenResident[screen])
+    {
+        AtomicStore(&loadFinished, 1);
+        return;
+    }
+
+    AtomicStore(&loadFinished, 0);
+    loadScreen = screen;
+    loadThread = StartThread(ScreenLoadThread, NULL);
+
+    // No threads available (i.e. web builds without pthreads), load in place
+    if (loadThread == NULL)
+    {
+        LoadScreen(screen);
+        AtomicStore(&loadFinished, 1);
+    }
+}
+
+static int ScreenLoadThread(void *arg)
+{
+    (void)arg;
+
+    LoadScreen(loadScreen);
+    AtomicStore(&loadFinished, 1);
+
+    return 0;
+}
+
+// Screens with a resume hook stay resident when left, until evicted
+static void LeaveScreen(GameScreen screen)
+{
+    if (screenTable[screen].resume != NULL) return;
+
+    screenTable[screen].unload();
+    screenResident[screen] = false;
+}
+
+static void EnterScreen(GameScreen screen)
+{
+    unsigned long long start = GetTimestampNs();
+    bool resumed = screenResident[screen];
+
+    if (resumed) screenTable[screen].resume();
+    else screenTable[screen].init();
+
+    screenResident[screen] = true;
+    screenLastUsed[screen] = ++screenClock;
+    currentScreen = screen;
+
+    TraceLog(LOG_INFO, "SCREEN: [%s] %s in %.2f ms", screenTable[screen].name, resumed? "Resumed" : "Initialized", (GetTimestampNs() - start)/1e6);
+
+    EvictScreens();
+}
+
+// Current screen is never evicted, it may be over budget on its own
+static void EvictScreens(void)
+{
+    size_t memory[SCREEN_COUNT] = { 0 };
+    size_t total = 0;
+
+    for (int i = 0; i < SCREEN_COUNT; i++)
+    {
+        if (screenResident[i] && (screenTable[i].memory != NULL)) memory[i] = screenTable[i].memory();
+        total += memory[i];
+    }
+
+    while (total > SCREEN_CACHE_BUDGET)
+    {
+        int oldest = -1;
+
+        for (int i = 0; i < SCREEN_COUNT; i++)
+        {
+            if (!screenResident[i] || (i == currentScreen) || (memory[i] == 0)) continue;
+            if ((oldest == -1) || (screenLastUsed[i] < screenLastUsed[oldest])) oldest = i;
+        }
+
+        if (oldest == -1) break;
+
+        screenTable[oldest].unload();
+        screenResident[oldest] = false;
+        total -= memory[oldest];
+
+        TraceLog(LOG_INFO, "SCREEN: [%s] Evicted, %zu KB freed, %zu KB resident", screenTable[oldest].name, memory[oldest]/1024, total/1024);
+    }
+}
+
+static void CheckScreenFinish(void)
+{
+    int finish = screenTable[currentScreen].finish();
+
+    if ((finish == 1) || (finish == 2)) TransitionToScreen(screenTable[currentScreen].next[finish - 1]);
+}
+
+// Update one fixed simulation tick, TICK_TIME seconds of game time
+static void UpdateTick(void)
+{
+    unsigned long long scopeStart = BeginProfileScope();
 
     if (!onTransition)
     {
-        switch(currentScreen)
+        if (screenTable[currentScreen].tickUpdate != NULL)
         {
-            case LOGO:
-            {
-                UpdateLogoScreen();
+            screenTable[currentScreen].tickUpdate();
+            CheckScreenFinish();
+        }
 
-                if (FinishLogoScreen()) TransitionToScreen(TITLE);
+        EndProfileScope(PROFILE_SCREEN_UPDATE, scopeStart);
+    }
+    else
+    {
+        UpdateTransition();     // Update transition (fade-in, fade-out)
+        EndProfileScope(PROFILE_TRANSITION, scopeStart);
+    }
+}
 
-            } break;
-            case TITLE:
-            {
-                UpdateTitleScreen();
+// Update and draw game frame
+static void UpdateDrawFrame(void)
+{
+    BeginProfileFrame();
 
-                if (FinishTitleScreen() == 1) TransitionToScreen(OPTIONS);
-                else if (FinishTitleScreen() == 2) TransitionToScreen(GAMEPLAY);
+    // Hold the frame until its deadline, before any work so the whole frame follows it
+    unsigned long long scopeStart = BeginProfileScope();
+    WaitFramePacer(&framePacer);
+    EndProfileScope(PROFILE_PACING, scopeStart);
 
-            } break;
-            case OPTIONS:
-            {
-                UpdateOptionsScreen();
+    // Update
+    //----------------------------------------------------------------------------------
 
-                if (FinishOptionsScreen()) TransitionToScreen(TITLE);
+    if (IsKeyPressed(KEY_F3)) showProfiler = !showProfiler;
 
-            } break;
-            case GAMEPLAY:
-            {
-                UpdateGameplayScreen();
+    // Menu screens only react to input, they are updated once per frame so no key press
+    // falls between two ticks; gameplay input is sampled here and consumed by next tick
+    scopeStart = BeginProfileScope();
 
-                if (FinishGameplayScreen() == 1) TransitionToScreen(ENDING);
-                //else if (FinishGameplayScreen() == 2) TransitionToScreen(TITLE);
+    if (!onTransition && (screenTable[currentScreen].frameUpdate != NULL))
+    {
+        screenTable[currentScreen].frameUpdate();
+        CheckScreenFinish();
+    }
+
+    EndProfileScope(PROFILE_SCREEN_UPDATE, scopeStart);
+
+    // Run as many fixed ticks as frame time allows, the backlog is capped so a long
+    // hitch does not make every following frame slower (spiral of death)
+    tickAccumulator += GetFrameTime();
+    if (tickAccumulator > MAX_TICKS_PER_FRAME*TICK_TIME) tickAccumulator = MAX_TICKS_PER_FRAME*TICK_TIME;
+
+    while (tickAccumulator >= TICK_TIME)
+    {
+        UpdateTick();
+        tickAccumulator -= TICK_TIME;
+    }
 
-            } break;
-            case ENDING:
-            {
-                UpdateEndingScreen();
+    // Leftover time, used to interpolate between the last two ticks when drawing
+    tickAlpha = tickAccumulator/TICK_TIME;
 
-                if (FinishEndingScreen() == 1) TransitionToScreen(TITLE);
+    UpdateSfx();    // Sounds triggered by this frame ticks, same sounds merged
+
+    // Late latching: cursor and aim are drawn from input of now, not of the last swap
+    // NOTE: Presses this poll sees are not seen as pressed by the next one, they are handled now,
+    // the screen polls itself so it can skip polling when it would not use the input (replays)
+    if (lateInput && !onTransition && (screenTable[currentScreen].lateSample != NULL))
+    {
+        unsigned long long sampleTime = BeginProfileScope();
 
-            } break;
-            default: break;
+        if (screenTable[currentScreen].lateSample())
+        {
+            inputSampleTime = sampleTime;
+            if (IsKeyPressed(KEY_F3)) showProfiler = !showProfiler;
         }
     }
-    else UpdateTransition();    // Update transition (fade-in, fade-out)
     //----------------------------------------------------------------------------------
 
     // Draw
@@ -281,21 +547,32 @@ static void UpdateDrawFrame(void)
 
         ClearBackground(RAYWHITE);
 
-        switch(currentScreen)
+        scopeStart = BeginProfileScope();
+
+        screenTable[currentScreen].draw();
+
+        EndProfileScope(PROFILE_DRAW, scopeStart);
+
+        // Draw full screen rectangle in front of everything
+        if (onTransition)
         {
-            case LOGO: DrawLogoScreen(); break;
-            case TITLE: DrawTitleScreen(); break;
-            case OPTIONS: DrawOptionsScreen(); break;
-            case GAMEPLAY: DrawGameplayScreen(); break;
-            case ENDING: DrawEndingScreen(); break;
-            default: break;
+            scopeStart = BeginProfileScope();
+            DrawTransition();
+            EndProfileScope(PROFILE_TRANSITION, scopeStart);
         }
 
-        // Draw full screen rectangle in front of everything
-        if (onTransition) DrawTransition();
+        if (showProfiler) DrawProfilerOverlay(GetScreenWidth() - 310, 10);
 
         //DrawFPS(10, 10);
 
+    scopeStart = BeginProfileScope();
     EndDrawing();
+    EndProfileScope(PROFILE_SWAP, scopeStart);
+
+    // EndDrawing() polls input last, next frame draws with it unless it is latched again
+    EndProfileScope(PROFILE_INPUT_LATENCY, inputSampleTime);
+    inputSampleTime = BeginProfileScope();
     //----------------------------------------------------------------------------------
+
+    EndProfileFrame();
 }
@@ -25,12 +25,19 @@
 
 #include "raylib.h"
 #include "screens.h"
+#include "compositor.h"
 
 //----------------------------------------------------------------------------------
 // Module Variables Definition (local)
 //----------------------------------------------------------------------------------
 static int framesCounter = 0;
 static int finishScreen = 0;
+static Compositor compositor = { 0 };      // Static screen, drawn from cache
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void DrawEndingLayer(void);
 
 //----------------------------------------------------------------------------------
 // Ending Screen Functions Definition
@@ -42,6 +49,16 @@ void InitEndingScreen(void)
     // TODO: Initialize ENDING screen variables here!
     framesCounter = 0;
     finishScreen = 0;
+
+    InitCompositor(&compositor, BLUE);
+    AddCompositorLayer(&compositor, DrawEndingLayer, true);
+}
+
+// Ending Screen Resume logic, screen stayed resident since it was left
+void ResumeEndingScreen(void)
+{
+    framesCounter = 0;
+    finishScreen = 0;
 }
 
 // Ending Screen Update logic
@@ -61,21 +78,34 @@ void UpdateEndingScreen(void)
 void DrawEndingScreen(void)
 {
     // TODO: Draw ENDING screen here!
-    DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), BLUE);
-
-    Vector2 pos = { 20, 10 };
-    DrawTextEx(font, "ENDING SCREEN", pos, font.baseSize*3.0f, 4, DARKBLUE);
-    DrawText("PRESS ENTER or TAP to RETURN to TITLE SCREEN", 120, 220, 20, DARKBLUE);
+    DrawCompositor(&compositor);
 }
 
 // Ending Screen Unload logic
 void UnloadEndingScreen(void)
 {
     // TODO: Unload ENDING screen variables here!
+    UnloadCompositor(&compositor);
 }
 
 // Ending Screen should finish?
 int FinishEndingScreen(void)
 {
     return finishScreen;
-}
\ No newline at end of file
+}
+
+// Ending Screen memory, its cached layer render texture
+size_t GetEndingScreenMemory(void)
+{
+    return GetCompositorMemory(&compositor);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static void DrawEndingLayer(void)
+{
+    Vector2 pos = { 20, 10 };
+    DrawTextEx(font, "ENDING SCREEN", pos, font.baseSize*3.0f, 4, DARKBLUE);
+    DrawText("PRESS ENTER or TAP to RETURN to TITLE SCREEN", 120, 220, 20, DARKBLUE);
+}
@@ -24,18 +24,17 @@
 **********************************************************************************************/
 
 #include "raylib.h"
-#include "raymath.h"
 #include "screens.h"
+#include "gameplay.h"
+#include "bullet_renderer.h"
+#include "particles.h"
+#include "particle_renderer.h"
+#include "input_log.h"
+#include "sfx.h"
+#include "hud.h"
+#include "compositor.h"
 
-#define MAX_BULLETS  640 //640 bullets ought to be enough for anyone
-
-typedef struct Bullets {
-    Vector2 origin;
-    Vector2 position;
-    Vector2 targetPosition;
-    float distance;
-    float speed;
-} Bullet;
+#include <math.h>           // Required for: atan2(), cos(), sin()
 
 //----------------------------------------------------------------------------------
 // Module Variables Definition (local)
@@ -43,15 +42,38 @@ typedef struct Bullets {
 static int framesCounter = 0;
 static int finishScreen = 0;
 static Vector2 cursorPosition;
-static Vector2 playerPosition;
-static int playerSize = 24;
+static bool fireRequested = false;          // Fire pressed since last tick
 static int playerGunLenght = 24;
-static float playerSpeed = 150.0f;
-static float playerProjectileSpeed = 300.0f;
-static Bullet bullets[MAX_BULLETS];
-// Keep track of how many bullets are flying around
-// Need to be decreased every time a bullet disappears!
-static int bulletCounter = 0;
+static float bulletRenderX[BULLETS_PER_CHUNK] = { 0 };     // Interpolated positions of one bullets chunk, for drawing
+static float bulletRenderY[BULLETS_PER_CHUNK] = { 0 };
+static int bulletsWidget = -1;              // HUD widgets
+
+// Effects, spawned from gameplay events and moved once per tick
+static const ParticleStyle muzzleStyle = { 8, 0.6f, 120.0f, 260.0f, 0.06f, 0.14f, 8.0f, 3.0f, { 255, 210, 140, 255 } };
+static const ParticleStyle sparkStyle = { 16, PI, 60.0f, 220.0f, 0.2f, 0.45f, 3.0f, 2.0f, { 255, 150, 60, 255 } };
+static ParticlePool muzzleParticles = { 0 };
+static ParticlePool sparkParticles = { 0 };
+
+// Targets only change when hit, they are drawn from cache below the moving layers
+static Compositor compositor = { 0 };
+static int targetsLayer = -1;
+static int targetsDrawn = -1;               // Target count and hits the cached layer shows
+static int targetHitsDrawn = -1;
+
+// Input recording and replay
+static const char *recordFileName = NULL;
+static const char *replayFileName = NULL;
+static InputLog inputLog = { 0 };
+static int replayMismatches = 0;
+static int replayFirstMismatch = -1;
+static bool replayFinished = false;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void DrawTargets(void);         // Compositor layers
+void DrawBullets(void);
+void DrawParticles(void);
 
 //----------------------------------------------------------------------------------
 // Gameplay Screen Functions Definition
@@ -64,37 +86,59 @@ void DrawCursor()
     DrawRectangle(cursorPosition.x - 3, cursorPosition.y + 3, 6, 12, RED);
 }
 
-Vector2 GetPointOnTrajectory(Vector2 origin, Vector2 target, float distance)
-{
-    Vector2 point;
-    double tanX = origin.x > target.x ? -(origin.x - target.x) : target.x - origin.x;
-    double tanY = origin.y > target.y ? origin.y - target.y : target.y - origin.y;
-    double angle = atan2(tanY, tanX);
-    point.x = origin.x + cos(angle) * distance;
-    point.y = origin.y + sin(-angle) * distance;
-    return point;
-}
-
-
 void DrawPlayer()
 {
+    // Draw between last two ticks, so movement stays smooth whatever the render rate
+    Vector2 position = GetPlayerPosition(tickAlpha);
+
     /*
         Calculate the angle of the gun
         atan2 gives the angle of the point from the origin (in radians)
         the origin needs to be the player position
     */
     
-    int tanX = playerPosition.x > cursorPosition.x ? -(playerPosition.x - cursorPosition.x) : cursorPosition.x - playerPosition.x;
-    int tanY = playerPosition.y > cursorPosition.y ? playerPosition.y - cursorPosition.y : 0;
+    int tanX = position.x > cursorPosition.x ? -(position.x - cursorPosition.x) : cursorPosition.x - position.x;
+    int tanY = position.y > cursorPosition.y ? position.y - cursorPosition.y : 0;
     double ang = atan2(tanY, tanX);
 
-    double gunX = playerPosition.x + cos(ang)  * playerGunLenght;
-    double gunY = playerPosition.y - sin(ang) * playerGunLenght;    
-    DrawCircle(playerPosition.x, playerPosition.y, playerSize / 2, RED);
-    DrawLine(playerPosition.x, playerPosition.y, gunX, gunY, RED);
+    double gunX = position.x + cos(ang)  * playerGunLenght;
+    double gunY = position.y - sin(ang) * playerGunLenght;    
+    DrawCircle(position.x, position.y, GetPlayerSize() / 2, RED);
+    DrawLine(position.x, position.y, gunX, gunY, RED);
 }
 
-// Gameplay Screen Initialization logic
+// Gameplay Screen Load logic
+// NOTE: Runs on the loader thread, no GPU or audio calls allowed here
+void LoadGameplayScreen(void)
+{
+    Rectangle screen = { 0, 0, GetScreenWidth(), GetScreenHeight() };
+
+    // Replay must start from the recorded state, whatever the window size is now
+    UnloadInputLog(inputLog);
+    inputLog = (InputLog){ screen, TICK_TIME, NULL, 0, 0 };
+    replayMismatches = 0;
+    replayFirstMismatch = -1;
+    replayFinished = false;
+
+    if (replayFileName != NULL)
+    {
+        inputLog = LoadInputLog(replayFileName);
+
+        if (inputLog.count == 0) TraceLog(LOG_WARNING, "REPLAY: [%s] Failed to load input log", replayFileName);
+        else if (inputLog.tickTime != TICK_TIME) TraceLog(LOG_WARNING, "REPLAY: [%s] Recorded with a different tick rate", replayFileName);
+        else TraceLog(LOG_INFO, "REPLAY: [%s] Replaying %i ticks", replayFileName, inputLog.count);
+
+        if (inputLog.count == 0) replayFinished = true;
+        else screen = inputLog.field;
+    }
+
+    InitGameplay(screen);
+
+    // Emitters come from the patterns file, shooter_bench replay places them the same way
+    AddGameplayPatternEmitters(&patterns);
+}
+
+// Gameplay Screen Initialization logic, runs once LoadGameplayScreen() is done
 void InitGameplayScreen(void)
 {
     // TODO: Initialize GAMEPLAY screen variables here!
@@ -102,117 +146,232 @@ void InitGameplayScreen(void)
     finishScreen = 0;
     cursorPosition.x = (GetScreenWidth() / 2);
     cursorPosition.y = (GetScreenHeight() / 2);
-    playerPosition.x = GetScreenWidth() / 2;
-    playerPosition.y = GetScreenHeight() - playerSize / 2;
+    fireRequested = false;
+
+    LoadBulletRenderer(4, WHITE);
+
+    LoadParticleRenderer();
+    muzzleParticles = LoadParticlePool(muzzleStyle, 4096);
+    sparkParticles = LoadParticlePool(sparkStyle, 32768);
+
+    LoadHud();
+    bulletsWidget = AddHudWidget("Bullets count:%d", 12, 24, 24, RAYWHITE);
+
+    InitCompositor(&compositor, BLACK);
+    targetsLayer = AddCompositorLayer(&compositor, DrawTargets, true);
+    AddCompositorLayer(&compositor, DrawBullets, false);
+    AddCompositorLayer(&compositor, DrawParticles, false);
+    AddCompositorLayer(&compositor, DrawPlayer, false);
+    AddCompositorLayer(&compositor, DrawCursor, false);
+    targetsDrawn = -1;
+    targetHitsDrawn = -1;
+}
+
+// Gameplay Screen Resume logic, simulation continues where it was left
+void ResumeGameplayScreen(void)
+{
+    framesCounter = 0;
+    finishScreen = 0;
+    fireRequested = false;
+}
+
+// Gameplay Screen input sampling, runs every frame
+void SampleGameplayInput(void)
+{
+    cursorPosition.x = GetMouseX();
+    cursorPosition.y = GetMouseY();
+
+    // Presses only last one frame, keep them until a tick consumes them
+    if (IsMouseButtonPressed(0)) fireRequested = true;
+
+    if (IsKeyPressed(KEY_TAB)) finishScreen = 2;    // Back to TITLE, simulation is kept
+}
+
+// Input polled again right before drawing, cursor and gun follow the mouse of now
+// NOTE: Replays draw the recorded cursor, input is not polled so presses wait for next frame
+bool LatchGameplayInput(void)
+{
+    if ((replayFileName != NULL) && (inputLog.count > 0)) return false;
+
+    PollInputEvents();
+    SampleGameplayInput();
+
+    return true;
+}
+
+// Sounds of last tick, started together at end of frame
+void PlayTickSounds(GameInput input)
+{
+    Vector2 position = GetPlayerPosition(1.0f);
+
+    SetSfxListener(position);
+    if (input.fire) PlaySfx(sfxShot, position, 0.5f);
 }
 
-void DeleteBullet(int bulletIndex)
+// Effects of last tick: particles move on, then gameplay events spawn new ones
+void UpdateTickParticles(float dt)
 {
-    if (bulletIndex > bulletCounter) return; //this shouldn't be possible, right?
-    for (int i = bulletIndex; i < bulletCounter - 1; i++)
+    const GameEvent *events = NULL;
+    int eventCount = GetGameplayEvents(&events);
+
+    UpdateParticles(&muzzleParticles, dt);
+    UpdateParticles(&sparkParticles, dt);
+
+    for (int i = 0; i < eventCount; i++)
     {
-        bullets[i] = bullets[i + 1];
+        if (events[i].type == GAME_EVENT_SHOT) EmitParticles(&muzzleParticles, events[i].position, events[i].direction);
+        else EmitParticles(&sparkParticles, events[i].position, events[i].direction);
     }
-    bulletCounter--;
-    return;
 }
 
-void UpdateBullets()
+// Feed next recorded tick to the simulation and check it ends in the recorded state
+void UpdateReplayTick()
 {
-    for (int b = 0; b < bulletCounter; b++)
+    int tick = GetGameplayTick();
+
+    if (tick >= inputLog.count)
     {
-        bullets[b].distance += playerProjectileSpeed * GetFrameTime();
-        Vector2 newBulletPosition = GetPointOnTrajectory(bullets[b].origin, bullets[b].targetPosition, bullets[b].distance);
-        // check collisions
-        // check out of screen
-        if (
-            newBulletPosition.x < 0 ||
-            newBulletPosition.x > GetScreenWidth() ||
-            newBulletPosition.y < 0 ||
-            newBulletPosition.y > GetScreenHeight()
-            )
+        if (!replayFinished)
         {
-            DeleteBullet(b);
+            if (replayMismatches == 0) TraceLog(LOG_INFO, "REPLAY: %i ticks replayed, all checksums match", inputLog.count);
+            else TraceLog(LOG_WARNING, "REPLAY: %i ticks replayed, %i checksums differ, first at tick %i", inputLog.count, replayMismatches, replayFirstMismatch);
         }
-        else 
+
+        replayFinished = true;
+        return;
+    }
+
+    UpdateGameplay(inputLog.ticks[tick].input, inputLog.tickTime);
+    PlayTickSounds(inputLog.ticks[tick].input);
+    UpdateTickParticles(inputLog.tickTime);
+    cursorPosition = inputLog.ticks[tick].input.cursor;
+
+    if (GetGameplayChecksum() != inputLog.ticks[tick].checksum)
+    {
+        if (replayMismatches == 0)
         {
-            bullets[b].position = newBulletPosition;
+            replayFirstMismatch = tick;
+            TraceLog(LOG_WARNING, "REPLAY: Checksum differs at tick %i, simulation diverged", tick);
         }
+
+        replayMismatches++;
     }
-    return;
 }
 
-void Fire(Vector2 origin, float speed, Vector2 target)
+// Gameplay Screen Update logic, runs every tick
+void UpdateGameplayScreen(void)
 {
-    if(bulletCounter < MAX_BULLETS)
+    if ((replayFileName != NULL) && (inputLog.count > 0))
     {
-        Bullet newBullet;
-        newBullet.origin = origin;
-        newBullet.position = origin;
-        newBullet.targetPosition = target;
-        newBullet.distance = 0;
-        newBullet.speed = playerProjectileSpeed;
-        bullets[bulletCounter++] = newBullet;
+        UpdateReplayTick();
+        return;
     }
-    return;
+
+    GameInput input = { 0 };
+    input.cursor = cursorPosition;
+    input.moveLeft = IsKeyDown(KEY_A);
+    input.moveRight = IsKeyDown(KEY_D);
+    input.fire = fireRequested;
+    fireRequested = false;
+
+    UpdateGameplay(input, TICK_TIME);
+    PlayTickSounds(input);
+    UpdateTickParticles(TICK_TIME);
+
+    if (recordFileName != NULL) AppendInputLog(&inputLog, input, GetGameplayChecksum());
 }
 
-// Gameplay Screen Update logic
-void UpdateGameplayScreen(void)
+void SetGameplayRecording(const char *fileName)
 {
-    float dt = GetFrameTime();
-    cursorPosition.x = GetMouseX();
-    cursorPosition.y = GetMouseY();
-    
-    if (IsKeyDown(KEY_A))
-    {
-        float newX = playerPosition.x - playerSpeed * dt;
-        if (newX >= playerSize / 2) playerPosition.x = newX;
-    }
-    
-    if (IsKeyDown(KEY_D))
-    {
-        float newX = playerPosition.x + playerSpeed * dt;
-        if (newX <= GetScreenWidth()) playerPosition.x = newX;
-    }
+    recordFileName = fileName;
+}
 
-    if (IsMouseButtonPressed(0))
+void SetGameplayReplay(const char *fileName)
+{
+    replayFileName = fileName;
+}
+
+bool IsGameplayReplayFinished(void)
+{
+    return replayFinished;
+}
+
+void DrawTargets()
+{
+    for (int t = 0; t < GetGameplayTargetCount(); t++)
     {
-        // fire!
-        Fire(playerPosition, playerProjectileSpeed, cursorPosition);
+        GameTarget target = GetGameplayTarget(t);
+
+        if (target.radius > 0.0f) DrawCircleLines(target.center.x, target.center.y, target.radius, RAYWHITE);
+        else DrawRectangleLines(target.center.x - target.halfSize.x, target.center.y - target.halfSize.y, 2*target.halfSize.x, 2*target.halfSize.y, RAYWHITE);
+
+        DrawText(TextFormat("%d", target.hits), target.center.x - 4, target.center.y - 5, 10, RAYWHITE);
     }
-    UpdateBullets();
 }
 
 void DrawBullets()
 {
-    for (int b = 0; b < bulletCounter; b++)
+    for (int c = 0; c < GetGameplayBulletChunkCount(); c++)
     {
-        DrawCircle(bullets[b].position.x, bullets[b].position.y, 4, WHITE);
+        int count = GetGameplayBulletRenderPositions(c, tickAlpha, TICK_TIME, bulletRenderX, bulletRenderY);
+        DrawBulletBatch(bulletRenderX, bulletRenderY, count);
     }
 }
 
+// One batch per pool
+void DrawParticles()
+{
+    DrawParticleBatch(&sparkParticles);
+    DrawParticleBatch(&muzzleParticles);
+}
+
 // Gameplay Screen Draw logic
 void DrawGameplayScreen(void)
 {
-    // TODO: Draw GAMEPLAY screen here!
-    DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), BLACK);
-    DrawCursor();
-    DrawPlayer();
-    DrawBullets();
+    // Hits only grow, their sum changes whenever a target does
+    int targetHits = 0;
+    for (int t = 0; t < GetGameplayTargetCount(); t++) targetHits += GetGameplayTarget(t).hits;
 
-    DrawText(
-        TextFormat("Bullets count:%d", bulletCounter), 
-        12, 24, 
-        24, 
-        RAYWHITE
-    );
+    if ((GetGameplayTargetCount() != targetsDrawn) || (targetHits != targetHitsDrawn))
+    {
+        InvalidateCompositorLayer(&compositor, targetsLayer);
+        targetsDrawn = GetGameplayTargetCount();
+        targetHitsDrawn = targetHits;
+    }
+
+    DrawCompositor(&compositor);
+
+    SetHudValue(bulletsWidget, GetGameplayBulletCount());
+    DrawHud();
 }
 
 // Gameplay Screen Unload logic
 void UnloadGameplayScreen(void)
 {
     // TODO: Unload GAMEPLAY screen variables here!
+    UnloadBulletRenderer();
+    UnloadParticlePool(&muzzleParticles);
+    UnloadParticlePool(&sparkParticles);
+    UnloadParticleRenderer();
+    UnloadHud();
+    UnloadCompositor(&compositor);
+    UnloadGameplay();
+
+    if (recordFileName != NULL)
+    {
+        if (SaveInputLog(inputLog, recordFileName)) TraceLog(LOG_INFO, "RECORD: [%s] %i ticks saved", recordFileName, inputLog.count);
+        else TraceLog(LOG_WARNING, "RECORD: [%s] Failed to save input log", recordFileName);
+    }
+
+    UnloadInputLog(inputLog);
+    inputLog = (InputLog){ 0 };
+}
+
+// Gameplay Screen memory, used to decide whether it can stay resident
+size_t GetGameplayScreenMemory(void)
+{
+    return GetGameplayMemory() + GetParticlePoolMemory(&muzzleParticles) + GetParticlePoolMemory(&sparkParticles) +
+           GetHudMemory() + GetCompositorMemory(&compositor);
 }
 
 // Gameplay Screen should finish?
@@ -25,6 +25,7 @@
 
 #include "raylib.h"
 #include "screens.h"
+#include "compositor.h"
 
 //----------------------------------------------------------------------------------
 // Module Variables Definition (local)
@@ -46,6 +47,16 @@ static int rightSideRecHeight = 0;
 static int state = 0;              // Logo animation states
 static float alpha = 1.0f;         // Useful for fading
 
+static Compositor compositor = { 0 };
+static int logoLayer = -1;
+static int logoLayerKey = -1;      // Animation step the cached logo layer shows
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void DrawLogoLayer(void);
+static int GetLogoLayerKey(void);  // Changes whenever the logo looks different, fade aside
+
 //----------------------------------------------------------------------------------
 // Logo Screen Functions Definition
 //----------------------------------------------------------------------------------
@@ -67,6 +78,11 @@ void InitLogoScreen(void)
 
     state = 0;
     alpha = 1.0f;
+
+    // Logo only changes every few frames and fades as a whole, it is drawn from cache
+    InitCompositor(&compositor, RAYWHITE);
+    logoLayer = AddCompositorLayer(&compositor, DrawLogoLayer, true);
+    logoLayerKey = -1;
 }
 
 // Logo Screen Update logic
@@ -126,6 +142,38 @@ void UpdateLogoScreen(void)
 
 // Logo Screen Draw logic
 void DrawLogoScreen(void)
+{
+    int key = GetLogoLayerKey();
+
+    if (key != logoLayerKey)
+    {
+        InvalidateCompositorLayer(&compositor, logoLayer);
+        logoLayerKey = key;
+    }
+
+    SetCompositorLayerAlpha(&compositor, logoLayer, alpha);
+    DrawCompositor(&compositor);
+}
+
+// Logo Screen Unload logic
+void UnloadLogoScreen(void)
+{
+    // Unload LOGO screen variables here!
+    UnloadCompositor(&compositor);
+}
+
+// Logo Screen should finish?
+int FinishLogoScreen(void)
+{
+    return finishScreen;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Logo at full alpha, the compositor applies the fade
+static void DrawLogoLayer(void)
 {
     if (state == 0)         // Draw blinking top-left square corner
     {
@@ -146,28 +194,28 @@ void DrawLogoScreen(void)
     }
     else if (state == 3)    // Draw "raylib" text-write animation + "powered by"
     {
-        DrawRectangle(logoPositionX, logoPositionY, topSideRecWidth, 16, Fade(BLACK, alpha));
-        DrawRectangle(logoPositionX, logoPositionY + 16, 16, leftSideRecHeight - 32, Fade(BLACK, alpha));
+        DrawRectangle(logoPositionX, logoPositionY, topSideRecWidth, 16, BLACK);
+        DrawRectangle(logoPositionX, logoPositionY + 16, 16, leftSideRecHeight - 32, BLACK);
 
-        DrawRectangle(logoPositionX + 240, logoPositionY + 16, 16, rightSideRecHeight - 32, Fade(BLACK, alpha));
-        DrawRectangle(logoPositionX, logoPositionY + 240, bottomSideRecWidth, 16, Fade(BLACK, alpha));
+        DrawRectangle(logoPositionX + 240, logoPositionY + 16, 16, rightSideRecHeight - 32, BLACK);
+        DrawRectangle(logoPositionX, logoPositionY + 240, bottomSideRecWidth, 16, BLACK);
 
-        DrawRectangle(GetScreenWidth()/2 - 112, GetScreenHeight()/2 - 112, 224, 224, Fade(RAYWHITE, alpha));
+        DrawRectangle(GetScreenWidth()/2 - 112, GetScreenHeight()/2 - 112, 224, 224, RAYWHITE);
 
-        DrawText(TextSubtext("raylib", 0, lettersCount), GetScreenWidth()/2 - 44, GetScreenHeight()/2 + 48, 50, Fade(BLACK, alpha));
+        DrawText(TextSubtext("raylib", 0, lettersCount), GetScreenWidth()/2 - 44, GetScreenHeight()/2 + 48, 50, BLACK);
 
-        if (framesCounter > 20) DrawText("powered by", logoPositionX, logoPositionY - 27, 20, Fade(DARKGRAY, alpha));
+        if (framesCounter > 20) DrawText("powered by", logoPositionX, logoPositionY - 27, 20, DARKGRAY);
     }
 }
 
-// Logo Screen Unload logic
-void UnloadLogoScreen(void)
+static int GetLogoLayerKey(void)
 {
-    // Unload LOGO screen variables here!
-}
+    int step = 0;
 
-// Logo Screen should finish?
-int FinishLogoScreen(void)
-{
-    return finishScreen;
+    if (state == 0) step = (framesCounter/10)%2;
+    else if (state == 1) step = topSideRecWidth;
+    else if (state == 2) step = bottomSideRecWidth;
+    else if (state == 3) step = lettersCount*2 + (framesCounter > 20);
+
+    return state*1024 + step;
 }
@@ -44,6 +44,13 @@ void InitOptionsScreen(void)
     finishScreen = 0;
 }
 
+// Options Screen Resume logic, screen stayed resident since it was left
+void ResumeOptionsScreen(void)
+{
+    framesCounter = 0;
+    finishScreen = 0;
+}
+
 // Options Screen Update logic
 void UpdateOptionsScreen(void)
 {
@@ -25,12 +25,19 @@
 
 #include "raylib.h"
 #include "screens.h"
+#include "compositor.h"
 
 //----------------------------------------------------------------------------------
 // Module Variables Definition (local)
 //----------------------------------------------------------------------------------
 static int framesCounter = 0;
 static int finishScreen = 0;
+static Compositor compositor = { 0 };      // Static screen, drawn from cache
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void DrawTitleLayer(void);
 
 //----------------------------------------------------------------------------------
 // Title Screen Functions Definition
@@ -42,6 +49,16 @@ void InitTitleScreen(void)
     // TODO: Initialize TITLE screen variables here!
     framesCounter = 0;
     finishScreen = 0;
+
+    InitCompositor(&compositor, GREEN);
+    AddCompositorLayer(&compositor, DrawTitleLayer, true);
+}
+
+// Title Screen Resume logic, screen stayed resident since it was left
+void ResumeTitleScreen(void)
+{
+    framesCounter = 0;
+    finishScreen = 0;
 }
 
 // Title Screen Update logic
@@ -62,20 +79,34 @@ void UpdateTitleScreen(void)
 void DrawTitleScreen(void)
 {
     // TODO: Draw TITLE screen here!
-    DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), GREEN);
-    Vector2 pos = { 20, 10 };
-    DrawTextEx(font, "TITLE SCREEN", pos, font.baseSize*3.0f, 4, DARKGREEN);
-    DrawText("PRESS ENTER or TAP to JUMP to GAMEPLAY SCREEN", 120, 220, 20, DARKGREEN);
+    DrawCompositor(&compositor);
 }
 
 // Title Screen Unload logic
 void UnloadTitleScreen(void)
 {
     // TODO: Unload TITLE screen variables here!
+    UnloadCompositor(&compositor);
 }
 
 // Title Screen should finish?
 int FinishTitleScreen(void)
 {
     return finishScreen;
-}
\ No newline at end of file
+}
+
+// Title Screen memory, its cached layer render texture
+size_t GetTitleScreenMemory(void)
+{
+    return GetCompositorMemory(&compositor);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static void DrawTitleLayer(void)
+{
+    Vector2 pos = { 20, 10 };
+    DrawTextEx(font, "TITLE SCREEN", pos, font.baseSize*3.0f, 4, DARKGREEN);
+    DrawText("PRESS ENTER or TAP to JUMP to GAMEPLAY SCREEN", 120, 220, 20, DARKGREEN);
+}
@@ -26,6 +26,17 @@
 #ifndef SCREENS_H
 #define SCREENS_H
 
+#include "patterns.h"       // Required for: BulletPatterns
+
+#include <stddef.h>         // Required for: size_t
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define TICK_RATE           60                  // Fixed simulation ticks per second
+#define TICK_TIME           (1.0f/TICK_RATE)    // Seconds simulated by every Update*Screen() call
+#define MAX_TICKS_PER_FRAME 5                   // Catch-up limit after a frame hitch
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
@@ -36,8 +47,10 @@ typedef enum GameScreen { UNKNOWN = -1, LOGO = 0, TITLE, OPTIONS, GAMEPLAY, ENDI
 //----------------------------------------------------------------------------------
 extern GameScreen currentScreen;
 extern Font font;
-extern Music music;
 extern Sound fxCoin;
+extern int sfxShot;          // Voice pool id of the shot sound, see sfx.h
+extern BulletPatterns patterns;  // Bullet patterns and emitter placements, see patterns.h
+extern float tickAlpha;     // Time between last tick and now, as a fraction of TICK_TIME [0..1)
 
 #ifdef __cplusplus
 extern "C" {            // Prevents name mangling of functions
@@ -56,15 +69,18 @@ int FinishLogoScreen(void);
 // Title Screen Functions Declaration
 //----------------------------------------------------------------------------------
 void InitTitleScreen(void);
+void ResumeTitleScreen(void);
 void UpdateTitleScreen(void);
 void DrawTitleScreen(void);
 void UnloadTitleScreen(void);
 int FinishTitleScreen(void);
+size_t GetTitleScreenMemory(void);   // Bytes held while resident, render textures
 
 //----------------------------------------------------------------------------------
 // Options Screen Functions Declaration
 //----------------------------------------------------------------------------------
 void InitOptionsScreen(void);
+void ResumeOptionsScreen(void);
 void UpdateOptionsScreen(void);
 void DrawOptionsScreen(void);
 void UnloadOptionsScreen(void);
@@ -73,20 +89,30 @@ int FinishOptionsScreen(void);
 //----------------------------------------------------------------------------------
 // Gameplay Screen Functions Declaration
 //----------------------------------------------------------------------------------
+void LoadGameplayScreen(void);      // CPU side loading, runs on the loader thread before Init
 void InitGameplayScreen(void);
+void ResumeGameplayScreen(void);
+void SampleGameplayInput(void);     // Called every frame, input is consumed by next tick
+bool LatchGameplayInput(void);      // Late input mode, polls and samples input again right before draw, false if not polled
 void UpdateGameplayScreen(void);
 void DrawGameplayScreen(void);
 void UnloadGameplayScreen(void);
 int FinishGameplayScreen(void);
+size_t GetGameplayScreenMemory(void);   // Bytes held while resident, heap and render textures
+void SetGameplayRecording(const char *fileName);    // Record input of next gameplay, saved on unload
+void SetGameplayReplay(const char *fileName);       // Replay recorded input on next gameplay, checking checksums
+bool IsGameplayReplayFinished(void);
 
 //----------------------------------------------------------------------------------
 // Ending Screen Functions Declaration
 //----------------------------------------------------------------------------------
 void InitEndingScreen(void);
+void ResumeEndingScreen(void);
 void UpdateEndingScreen(void);
 void DrawEndingScreen(void);
 void UnloadEndingScreen(void);
 int FinishEndingScreen(void);
+size_t GetEndingScreenMemory(void);   // Bytes held while resident, render textures
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,252 @@
+/**********************************************************************************************
+*
+*   Sfx - Polyphonic sound effects over a fixed voice pool
+*
+*   See sfx.h for an overview.
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+#include "raymath.h"        // Required for: Vector2Distance()
+#include "sfx.h"
+
+#define SFX_MAX_ALIASES     64      // Voices preallocated, all sounds
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct SfxSound {
+    int firstVoice;             // Voices of this sound are voices[firstVoice .. firstVoice + voiceCount)
+    int voiceCount;
+    int priority;
+} SfxSound;
+
+typedef struct SfxVoice {
+    Sound alias;                // Shares samples with the registered sound
+    bool playing;
+    int priority;
+    float loudness;             // Volume after distance attenuation, when started
+    unsigned int started;       // Frame it was started
+} SfxVoice;
+
+typedef struct SfxTrigger {
+    int sfx;
+    int priority;
+    float loudness;
+} SfxTrigger;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static SfxSound sounds[SFX_MAX_SOUNDS] = { 0 };
+static int soundCount = 0;
+static SfxVoice voices[SFX_MAX_ALIASES] = { 0 };
+static int voiceCount = 0;
+static int playingVoices = 0;
+
+static SfxTrigger triggers[SFX_MAX_TRIGGERS] = { 0 };
+static int triggerCount = 0;
+
+static Vector2 listener = { 0 };
+static float maxDistance = 1.0f;
+static unsigned int frameCounter = 0;
+static SfxStats stats = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static bool IsVoiceLessImportant(const SfxVoice *voice, int priority, float loudness, unsigned int started);
+static int FindVictimVoice(int first, int count);   // Least important playing voice, -1 if none
+static void StartTrigger(SfxTrigger trigger);
+
+//----------------------------------------------------------------------------------
+// Sfx Functions Definition
+//----------------------------------------------------------------------------------
+void InitSfx(float distance)
+{
+    CloseSfx();
+
+    maxDistance = (distance > 0.0f)? distance : 1.0f;
+    listener = (Vector2){ 0 };
+    frameCounter = 0;
+    stats = (SfxStats){ 0 };
+}
+
+void CloseSfx(void)
+{
+    for (int i = 0; i < voiceCount; i++) UnloadSoundAlias(voices[i].alias);
+
+    soundCount = 0;
+    voiceCount = 0;
+    playingVoices = 0;
+    triggerCount = 0;
+}
+
+// Voices are allocated now, playing never allocates
+int LoadSfx(Sound sound, int maxVoices, int priority)
+{
+    if ((soundCount >= SFX_MAX_SOUNDS) || (maxVoices <= 0) || (sound.frameCount == 0)) return -1;
+    if (voiceCount + maxVoices > SFX_MAX_ALIASES) maxVoices = SFX_MAX_ALIASES - voiceCount;
+    if (maxVoices <= 0) return -1;
+
+    SfxSound *entry = &sounds[soundCount];
+    entry->firstVoice = voiceCount;
+    entry->voiceCount = maxVoices;
+    entry->priority = priority;
+
+    for (int i = 0; i < maxVoices; i++)
+    {
+        voices[voiceCount] = (SfxVoice){ 0 };
+        voices[voiceCount].alias = LoadSoundAlias(sound);
+        voiceCount++;
+    }
+
+    return soundCount++;
+}
+
+void PlaySfx(int sfx, Vector2 position, float volume)
+{
+    if ((sfx < 0) || (sfx >= soundCount)) return;
+
+    stats.triggers++;
+
+    float attenuation = 1.0f - Vector2Distance(position, listener)/maxDistance;
+    float loudness = volume*Clamp(attenuation, 0.0f, 1.0f);
+
+    // Same sound already triggered this frame, keep the loudest
+    for (int i = 0; i < triggerCount; i++)
+    {
+        if (triggers[i].sfx == sfx)
+        {
+            if (loudness > triggers[i].loudness) triggers[i].loudness = loudness;
+            stats.merged++;
+            return;
+        }
+    }
+
+    if (triggerCount >= SFX_MAX_TRIGGERS)
+    {
+        stats.dropped++;
+        return;
+    }
+
+    triggers[triggerCount++] = (SfxTrigger){ sfx, sounds[sfx].priority, loudness };
+}
+
+void SetSfxListener(Vector2 position)
+{
+    listener = position;
+}
+
+void UpdateSfx(void)
+{
+    frameCounter++;
+
+    // Voices that ended are idle again
+    playingVoices = 0;
+    for (int i = 0; i < voiceCount; i++)
+    {
+        if (voices[i].playing && !IsSoundPlaying(voices[i].alias)) voices[i].playing = false;
+        if (voices[i].playing) playingVoices++;
+    }
+
+    // Most important triggers pick their voice first, insertion sort on a few entries
+    for (int i = 1; i < triggerCount; i++)
+    {
+        SfxTrigger trigger = triggers[i];
+        int j = i - 1;
+
+        while ((j >= 0) && ((triggers[j].priority < trigger.priority) ||
+               ((triggers[j].priority == trigger.priority) && (triggers[j].loudness < trigger.loudness))))
+        {
+            triggers[j + 1] = triggers[j];
+            j--;
+        }
+
+        triggers[j + 1] = trigger;
+    }
+
+    for (int i = 0; i < triggerCount; i++) StartTrigger(triggers[i]);
+
+    triggerCount = 0;
+    stats.playingVoices = playingVoices;
+}
+
+SfxStats GetSfxStats(void)
+{
+    return stats;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Lower priority first, then quieter, then older
+static bool IsVoiceLessImportant(const SfxVoice *voice, int priority, float loudness, unsigned int started)
+{
+    if (voice->priority != priority) return (voice->priority < priority);
+    if (voice->loudness != loudness) return (voice->loudness < loudness);
+
+    return (voice->started < started);
+}
+
+static int FindVictimVoice(int first, int count)
+{
+    int victim = -1;
+
+    for (int i = first; i < first + count; i++)
+    {
+        if (!voices[i].playing) continue;
+        if ((victim == -1) || IsVoiceLessImportant(&voices[i], voices[victim].priority, voices[victim].loudness, voices[victim].started)) victim = i;
+    }
+
+    return victim;
+}
+
+static void StartTrigger(SfxTrigger trigger)
+{
+    const SfxSound *sound = &sounds[trigger.sfx];
+
+    if (trigger.loudness <= 0.0f)
+    {
+        stats.dropped++;    // Out of hearing range
+        return;
+    }
+
+    int voice = -1;
+    for (int i = sound->firstVoice; (i < sound->firstVoice + sound->voiceCount) && (voice == -1); i++)
+    {
+        if (!voices[i].playing) voice = i;
+    }
+
+    // Sound at its own limit steals one of its voices, pool at its limit steals any voice
+    int victim = -1;
+    if (voice == -1) victim = FindVictimVoice(sound->firstVoice, sound->voiceCount);
+    else if (playingVoices >= SFX_MAX_VOICES) victim = FindVictimVoice(0, voiceCount);
+
+    if (victim != -1)
+    {
+        if (!IsVoiceLessImportant(&voices[victim], trigger.priority, trigger.loudness, frameCounter))
+        {
+            stats.dropped++;
+            return;
+        }
+
+        StopSound(voices[victim].alias);
+        voices[victim].playing = false;
+        playingVoices--;
+        stats.stolen++;
+
+        if (voice == -1) voice = victim;
+    }
+
+    SfxVoice *entry = &voices[voice];
+    entry->playing = true;
+    entry->priority = trigger.priority;
+    entry->loudness = trigger.loudness;
+    entry->started = frameCounter;
+
+    SetSoundVolume(entry->alias, trigger.loudness);
+    PlaySound(entry->alias);
+    playingVoices++;
+}
@@ -0,0 +1,56 @@
+/**********************************************************************************************
+*
+*   Sfx - Polyphonic sound effects over a fixed voice pool
+*
+*   Every registered sound gets its voices preallocated as aliases of its Sound, they share
+*   its samples. Playing a sound only queues a trigger, UpdateSfx() starts the queued ones
+*   once per frame: triggers of one sound in the same frame are merged into a single voice,
+*   so the number of playing voices (and mixer time) stays bounded whatever the trigger rate.
+*
+*   When a sound has no idle voice, or SFX_MAX_VOICES are playing, the least important
+*   playing voice is stopped for the new one: lower priority first, then quieter (further
+*   from the listener), then older. A trigger less important than every candidate is dropped.
+*
+**********************************************************************************************/
+
+#ifndef SFX_H
+#define SFX_H
+
+#include "raylib.h"
+
+#define SFX_MAX_SOUNDS      16      // Registered sounds
+#define SFX_MAX_VOICES      24      // Voices playing at once, all sounds
+#define SFX_MAX_TRIGGERS    64      // Triggers queued per frame, extra ones are dropped
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct SfxStats {
+    int playingVoices;          // After last UpdateSfx()
+    int triggers;               // PlaySfx() calls since InitSfx()
+    int merged;                 // Triggers merged with another one of the same frame
+    int stolen;                 // Voices stopped for a more important trigger
+    int dropped;                // Triggers not played, queue full or less important than every voice
+} SfxStats;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Sfx Functions Declaration
+//----------------------------------------------------------------------------------
+void InitSfx(float maxDistance);                    // Sounds are silent at maxDistance from listener
+void CloseSfx(void);                                // Unload every voice, sources are not unloaded
+int LoadSfx(Sound sound, int maxVoices, int priority);  // Returns sound id, -1 on failure, sound must outlive it
+
+void PlaySfx(int sfx, Vector2 position, float volume);  // Queued until next UpdateSfx()
+void SetSfxListener(Vector2 position);
+void UpdateSfx(void);                               // Start queued triggers, once per frame
+SfxStats GetSfxStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SFX_H
@@ -0,0 +1,363 @@
+/**********************************************************************************************
+*
+*   Snapshot - Ring of recent gameplay snapshots, delta encoded
+*
+*   See snapshot.h for an overview.
+*
+*   Delta format, native byte order:
+*     int size              Bytes of data
+*     then runs of:
+*       int unchanged       Words equal to base, copied from it
+*       int changed         Words that differ, followed by them XORed with base
+*     Words after the last run are unchanged. A word is 4 bytes, the last one of data and
+*     base is padded with zeros, so are words past the end of base.
+*
+**********************************************************************************************/
+
+#include "snapshot.h"
+
+#include <stdlib.h>         // Required for: calloc(), realloc(), free()
+#include <string.h>         // Required for: memcpy(), memset(), memcmp()
+
+#define SNAPSHOT_MIN_UNCHANGED  3       // Shorter unchanged runs are left inside changed runs, a run header is 2 words
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int GetWord(const unsigned char *bytes, int size, int index);  // Zero padded past size
+static unsigned long long GetPair(const unsigned char *bytes, int index);      // Words index and index + 1, no bounds check
+static void SetWord(unsigned char *bytes, int size, int index, unsigned int word);
+static void CopyWords(unsigned char *data, int size, const unsigned char *base, int baseSize, int start, int end);
+static int FindEntry(const SnapshotRing *ring, int tick);  // Returns -1 if tick is not kept
+static bool SetEntryData(SnapshotEntry *entry, const void *data, int size);
+
+//----------------------------------------------------------------------------------
+// Snapshot Functions Definition
+//----------------------------------------------------------------------------------
+SnapshotRing LoadSnapshotRing(int ticks, int keyInterval)
+{
+    SnapshotRing ring = { 0 };
+
+    if (ticks < 1) ticks = 1;
+    if (keyInterval < 1) keyInterval = 1;
+
+    ring.capacity = ticks + keyInterval - 1;
+    ring.keyInterval = keyInterval;
+    ring.entries = (SnapshotEntry *)calloc(ring.capacity, sizeof(SnapshotEntry));
+
+    if (ring.entries == NULL) ring.capacity = 0;
+
+    return ring;
+}
+
+void UnloadSnapshotRing(SnapshotRing ring)
+{
+    for (int i = 0; i < ring.capacity; i++) free(ring.entries[i].data);
+
+    free(ring.entries);
+    free(ring.scratch);
+}
+
+// Store as a delta against the key of the newest snapshot, or as a new key
+void PushSnapshot(SnapshotRing *ring, int tick, const void *data, int size)
+{
+    if ((ring->capacity == 0) || (size < 0)) return;
+
+    // Rolled back, snapshots from this tick on are another timeline
+    while ((ring->count > 0) && (ring->entries[(ring->first + ring->count - 1)%ring->capacity].tick >= tick)) ring->count--;
+
+    // Full, oldest key goes along with its deltas
+    if (ring->count == ring->capacity)
+    {
+        do
+        {
+            ring->first = (ring->first + 1)%ring->capacity;
+            ring->count--;
+        } while ((ring->count > 0) && (ring->entries[ring->first].key != ring->first));
+    }
+
+    int index = (ring->first + ring->count)%ring->capacity;
+    SnapshotEntry *entry = &ring->entries[index];
+    bool stored = false;
+
+    if (ring->count > 0)
+    {
+        int key = ring->entries[(ring->first + ring->count - 1)%ring->capacity].key;
+        const SnapshotEntry *keyEntry = &ring->entries[key];
+
+        if ((index - key + ring->capacity)%ring->capacity < ring->keyInterval)
+        {
+            int bound = GetSnapshotDeltaBound(size);
+
+            if (ring->scratchSize < bound)
+            {
+                unsigned char *scratch = (unsigned char *)realloc(ring->scratch, bound);
+                if (scratch == NULL) return;
+
+                ring->scratch = scratch;
+                ring->scratchSize = bound;
+            }
+
+            int deltaSize = EncodeSnapshotDelta(keyEntry->data, keyEntry->size, data, size, ring->scratch, ring->scratchSize);
+
+            // A delta as big as the snapshot saves nothing, it becomes a key
+            if ((deltaSize > 0) && (deltaSize < size))
+            {
+                if (!SetEntryData(entry, ring->scratch, deltaSize)) return;
+
+                entry->key = key;
+                stored = true;
+            }
+        }
+    }
+
+    if (!stored)
+    {
+        if (!SetEntryData(entry, data, size)) return;
+        entry->key = index;
+    }
+
+    entry->tick = tick;
+    entry->size = size;
+    ring->count++;
+}
+
+int GetSnapshotSize(const SnapshotRing *ring, int tick)
+{
+    int index = FindEntry(ring, tick);
+
+    return (index != -1)? ring->entries[index].size : 0;
+}
+
+// One decode over the key, or a copy for keys
+int GetSnapshot(const SnapshotRing *ring, int tick, void *data, int capacity)
+{
+    int index = FindEntry(ring, tick);
+    if ((index == -1) || (ring->entries[index].size > capacity)) return 0;
+
+    const SnapshotEntry *entry = &ring->entries[index];
+    const SnapshotEntry *key = &ring->entries[entry->key];
+
+    if (entry->key == index)
+    {
+        memcpy(data, entry->data, entry->size);
+        return entry->size;
+    }
+
+    return DecodeSnapshotDelta(key->data, key->size, entry->data, entry->dataSize, data, capacity);
+}
+
+bool IsSnapshotKey(const SnapshotRing *ring, int tick)
+{
+    int index = FindEntry(ring, tick);
+
+    return (index != -1) && (ring->entries[index].key == index);
+}
+
+size_t GetSnapshotRingMemory(const SnapshotRing *ring)
+{
+    size_t memory = ring->capacity*sizeof(SnapshotEntry) + ring->scratchSize;
+
+    for (int i = 0; i < ring->capacity; i++) memory += ring->entries[i].dataCapacity;
+
+    return memory;
+}
+
+size_t GetSnapshotRingStoredSize(const SnapshotRing *ring)
+{
+    size_t size = 0;
+
+    for (int i = 0; i < ring->count; i++) size += ring->entries[(ring->first + i)%ring->capacity].dataSize;
+
+    return size;
+}
+
+// Size header, then at most one run header per SNAPSHOT_MIN_UNCHANGED + 1 words and every word
+int GetSnapshotDeltaBound(int size)
+{
+    return 3*(int)sizeof(int) + 4*((size + 3)/4);
+}
+
+int EncodeSnapshotDelta(const void *base, int baseSize, const void *data, int size, unsigned char *delta, int capacity)
+{
+    const unsigned char *baseBytes = (const unsigned char *)base;
+    const unsigned char *dataBytes = (const unsigned char *)data;
+    int wordCount = (size + 3)/4;
+    int commonWords = ((size < baseSize)? size : baseSize)/4;     // Whole words in both, read without padding
+    int deltaSize = (int)sizeof(int);
+    int i = 0;
+
+    if (capacity < deltaSize) return 0;
+    memcpy(delta, &size, sizeof(int));
+
+    while (i < wordCount)
+    {
+        int start = i;
+
+        // Most of a snapshot is unchanged, skip it two words at a time
+        while ((i + 2 <= commonWords) && (GetPair(dataBytes, i) == GetPair(baseBytes, i))) i += 2;
+        while ((i < wordCount) && (GetWord(dataBytes, size, i) == GetWord(baseBytes, baseSize, i))) i++;
+
+        if (i == wordCount) break;      // Trailing unchanged words are implied
+
+        int header = deltaSize;
+        int changedStart = i;
+        int unchanged = 0;
+
+        if (deltaSize + 2*(int)sizeof(int) + 4*(wordCount - i) > capacity) return 0;
+        deltaSize += 2*(int)sizeof(int);
+
+        // Changed run ends on enough unchanged words to pay for a new run header, or at the end
+        while ((i < wordCount) && (unchanged < SNAPSHOT_MIN_UNCHANGED))
+        {
+            unsigned int word = (i < commonWords)? GetWord(dataBytes, 4*commonWords, i) ^ GetWord(baseBytes, 4*commonWords, i) :
+                                                   GetWord(dataBytes, size, i) ^ GetWord(baseBytes, baseSize, i);
+
+            memcpy(delta + deltaSize, &word, 4);
+            deltaSize += 4;
+            i++;
+            unchanged = (word == 0)? unchanged + 1 : 0;
+        }
+
+        // Unchanged words the run ended on are given back
+        i -= unchanged;
+        deltaSize -= 4*unchanged;
+
+        int run[2] = { changedStart - start, i - changedStart };
+        memcpy(delta + header, run, sizeof(run));
+    }
+
+    return deltaSize;
+}
+
+int DecodeSnapshotDelta(const void *base, int baseSize, const unsigned char *delta, int deltaSize, void *data, int capacity)
+{
+    const unsigned char *baseBytes = (const unsigned char *)base;
+    unsigned char *dataBytes = (unsigned char *)data;
+    int size = 0;
+
+    if (deltaSize < (int)sizeof(int)) return 0;
+    memcpy(&size, delta, sizeof(int));
+    if ((size < 0) || (size > capacity)) return 0;
+
+    int wordCount = (size + 3)/4;
+    int position = (int)sizeof(int);
+    int w = 0;
+
+    while (position < deltaSize)
+    {
+        int run[2] = { 0 };
+        if (deltaSize - position < (int)sizeof(run)) return 0;
+
+        memcpy(run, delta + position, sizeof(run));
+        position += (int)sizeof(run);
+
+        if ((run[0] < 0) || (run[1] < 0) || (run[0] > wordCount - w) || (run[1] > wordCount - w - run[0]) ||
+            (4*run[1] > deltaSize - position)) return 0;
+
+        CopyWords(dataBytes, size, baseBytes, baseSize, w, w + run[0]);
+        w += run[0];
+
+        for (int i = 0; i < run[1]; i++, w++)
+        {
+            unsigned int word = 0;
+            memcpy(&word, delta + position, 4);
+            position += 4;
+
+            SetWord(dataBytes, size, w, word ^ GetWord(baseBytes, baseSize, w));
+        }
+    }
+
+    CopyWords(dataBytes, size, baseBytes, baseSize, w, wordCount);
+
+    return size;
+}
+
+int FindSnapshotDifference(const void *a, int sizeA, const void *b, int sizeB)
+{
+    const unsigned char *bytesA = (const unsigned char *)a;
+    const unsigned char *bytesB = (const unsigned char *)b;
+    int size = (sizeA < sizeB)? sizeA : sizeB;
+
+    for (int i = 0; i < size; i++)
+    {
+        if (bytesA[i] != bytesB[i]) return i;
+    }
+
+    return (sizeA != sizeB)? size : -1;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static unsigned int GetWord(const unsigned char *bytes, int size, int index)
+{
+    unsigned int word = 0;
+    int offset = 4*index;
+
+    if (offset + 4 <= size) memcpy(&word, bytes + offset, 4);
+    else if (offset < size) memcpy(&word, bytes + offset, size - offset);
+
+    return word;
+}
+
+static unsigned long long GetPair(const unsigned char *bytes, int index)
+{
+    unsigned long long pair = 0;
+    memcpy(&pair, bytes + 4*index, 8);
+
+    return pair;
+}
+
+static void SetWord(unsigned char *bytes, int size, int index, unsigned int word)
+{
+    int offset = 4*index;
+
+    if (offset + 4 <= size) memcpy(bytes + offset, &word, 4);
+    else if (offset < size) memcpy(bytes + offset, &word, size - offset);
+}
+
+// Words [start, end) of data from base, zeros past the end of base
+static void CopyWords(unsigned char *data, int size, const unsigned char *base, int baseSize, int start, int end)
+{
+    int from = 4*start;
+    int to = (4*end < size)? 4*end : size;
+    int copied = (to < baseSize)? to : baseSize;
+
+    if (copied > from) memcpy(data + from, base + from, copied - from);
+    else copied = from;
+
+    if (to > copied) memset(data + copied, 0, to - copied);
+}
+
+// Newest first, lookups are mostly for recent ticks
+static int FindEntry(const SnapshotRing *ring, int tick)
+{
+    for (int i = ring->count - 1; i >= 0; i--)
+    {
+        int index = (ring->first + i)%ring->capacity;
+
+        if (ring->entries[index].tick == tick) return index;
+        if (ring->entries[index].tick < tick) break;
+    }
+
+    return -1;
+}
+
+// Buffer fits the data, it shrinks back when a delta follows a key in the same entry
+static bool SetEntryData(SnapshotEntry *entry, const void *data, int size)
+{
+    if ((size > entry->dataCapacity) || (size < entry->dataCapacity/2))
+    {
+        unsigned char *buffer = (unsigned char *)realloc(entry->data, (size > 0)? size : 1);
+        if (buffer == NULL) return false;
+
+        entry->data = buffer;
+        entry->dataCapacity = (size > 0)? size : 1;
+    }
+
+    memcpy(entry->data, data, size);
+    entry->dataSize = size;
+
+    return true;
+}
@@ -0,0 +1,77 @@
+/**********************************************************************************************
+*
+*   Snapshot - Ring of recent gameplay snapshots, delta encoded
+*
+*   Keeps the snapshots of the last ticks (SaveGameplayState() buffers, or any other bytes)
+*   so any of them can be restored: rollback, replays from the middle, divergence checks.
+*
+*   Every keyInterval snapshots one is stored whole (a key), the ones after it are stored as
+*   a delta against it: both are XORed word by word, runs of unchanged words become a count.
+*   Most of a tick is unchanged from a few ticks before (targets, emitters, bullets that did
+*   not die or spawn), deltas are a fraction of a snapshot. Restoring decodes one delta over
+*   its key, whatever the distance to the key, so it costs about a copy of the snapshot.
+*
+*   Keys are only dropped with every delta depending on them: the ring holds up to
+*   ticks + keyInterval - 1 snapshots, so the last ticks are always there.
+*
+*   Pushing a tick that is not newer than the last one drops every snapshot from that tick
+*   on first: after a rollback the simulation runs again from the restored tick.
+*
+**********************************************************************************************/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>        // Required for: bool
+#include <stddef.h>         // Required for: size_t
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct SnapshotEntry {
+    int tick;
+    int size;               // Bytes of the snapshot, decoded
+    int key;                // Entry holding the key this one is a delta against, itself for keys
+    unsigned char *data;    // Snapshot for keys, delta otherwise
+    int dataSize;
+    int dataCapacity;
+} SnapshotEntry;
+
+typedef struct SnapshotRing {
+    SnapshotEntry *entries;
+    int capacity;           // Entries, ticks + keyInterval - 1
+    int keyInterval;        // Snapshots per key, key included
+    int first;              // Oldest entry
+    int count;
+    unsigned char *scratch; // Delta being encoded, before it is copied into its entry
+    int scratchSize;
+} SnapshotRing;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Snapshot Functions Declaration
+//----------------------------------------------------------------------------------
+SnapshotRing LoadSnapshotRing(int ticks, int keyInterval);     // Keeps at least the last ticks snapshots
+void UnloadSnapshotRing(SnapshotRing ring);
+void PushSnapshot(SnapshotRing *ring, int tick, const void *data, int size);
+int GetSnapshotSize(const SnapshotRing *ring, int tick);       // Returns 0 if tick is not kept
+int GetSnapshot(const SnapshotRing *ring, int tick, void *data, int capacity);     // Returns size, 0 if not kept or capacity is too small
+bool IsSnapshotKey(const SnapshotRing *ring, int tick);
+size_t GetSnapshotRingMemory(const SnapshotRing *ring);        // Bytes allocated
+size_t GetSnapshotRingStoredSize(const SnapshotRing *ring);    // Bytes of keys and deltas, encoded
+
+// Delta of data against base, sizes may differ, missing bytes of base are zeros
+int GetSnapshotDeltaBound(int size);                            // Largest delta of size bytes of data
+int EncodeSnapshotDelta(const void *base, int baseSize, const void *data, int size, unsigned char *delta, int capacity);    // Returns delta size, 0 if capacity is too small
+int DecodeSnapshotDelta(const void *base, int baseSize, const unsigned char *delta, int deltaSize, void *data, int capacity);   // Returns data size, 0 if delta is not valid or capacity is too small
+
+int FindSnapshotDifference(const void *a, int sizeA, const void *b, int sizeB);  // First byte that differs, -1 if snapshots are equal
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,267 @@
+/**********************************************************************************************
+*
+*   Threads - Minimal portable threading primitives
+*
+*   NOTE: This module must not include raylib.h, windows.h declarations collide with it
+*
+**********************************************************************************************/
+
+#include "threads.h"
+
+#include <stdlib.h>         // Required for: malloc(), free()
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #include <process.h>    // Required for: _beginthreadex()
+#else
+    #include <pthread.h>
+    #include <sched.h>      // Required for: sched_yield()
+    #include <time.h>       // Required for: nanosleep()
+    #include <unistd.h>     // Required for: sysconf()
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+struct Thread {
+#if defined(_WIN32)
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+    ThreadFunc func;
+    void *arg;
+};
+
+struct Mutex {
+#if defined(_WIN32)
+    SRWLOCK lock;
+#else
+    pthread_mutex_t lock;
+#endif
+};
+
+struct CondVar {
+#if defined(_WIN32)
+    CONDITION_VARIABLE cond;
+#else
+    pthread_cond_t cond;
+#endif
+};
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+#if defined(_WIN32)
+static unsigned __stdcall ThreadEntry(void *arg)
+{
+    Thread *thread = (Thread *)arg;
+    return (unsigned)thread->func(thread->arg);
+}
+#else
+static void *ThreadEntry(void *arg)
+{
+    Thread *thread = (Thread *)arg;
+    thread->func(thread->arg);
+    return NULL;
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Threads Functions Definition
+//----------------------------------------------------------------------------------
+Thread *StartThread(ThreadFunc func, void *arg)
+{
+    Thread *thread = (Thread *)malloc(sizeof(Thread));
+    if (thread == NULL) return NULL;
+
+    thread->func = func;
+    thread->arg = arg;
+
+#if defined(_WIN32)
+    thread->handle = (HANDLE)_beginthreadex(NULL, 0, ThreadEntry, thread, 0, NULL);
+    if (thread->handle == 0)
+#else
+    if (pthread_create(&thread->handle, NULL, ThreadEntry, thread) != 0)
+#endif
+    {
+        free(thread);
+        return NULL;
+    }
+
+    return thread;
+}
+
+void JoinThread(Thread *thread)
+{
+    if (thread == NULL) return;
+
+#if defined(_WIN32)
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+    free(thread);
+}
+
+void YieldThread(void)
+{
+#if defined(_WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+void SleepThread(int milliseconds)
+{
+#if defined(_WIN32)
+    Sleep((DWORD)milliseconds);
+#else
+    struct timespec duration = { milliseconds/1000, (long)(milliseconds%1000)*1000000L };
+    nanosleep(&duration, NULL);
+#endif
+}
+
+int GetCpuCount(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info = { 0 };
+    GetSystemInfo(&info);
+    int count = (int)info.dwNumberOfProcessors;
+#else
+    int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+    return (count > 0)? count : 1;
+}
+
+Mutex *LoadMutex(void)
+{
+    Mutex *mutex = (Mutex *)malloc(sizeof(Mutex));
+
+#if defined(_WIN32)
+    InitializeSRWLock(&mutex->lock);
+#else
+    pthread_mutex_init(&mutex->lock, NULL);
+#endif
+
+    return mutex;
+}
+
+void UnloadMutex(Mutex *mutex)
+{
+    if (mutex == NULL) return;
+
+#if !defined(_WIN32)
+    pthread_mutex_destroy(&mutex->lock);
+#endif
+    free(mutex);
+}
+
+void LockMutex(Mutex *mutex)
+{
+#if defined(_WIN32)
+    AcquireSRWLockExclusive(&mutex->lock);
+#else
+    pthread_mutex_lock(&mutex->lock);
+#endif
+}
+
+void UnlockMutex(Mutex *mutex)
+{
+#if defined(_WIN32)
+    ReleaseSRWLockExclusive(&mutex->lock);
+#else
+    pthread_mutex_unlock(&mutex->lock);
+#endif
+}
+
+CondVar *LoadCondVar(void)
+{
+    CondVar *cond = (CondVar *)malloc(sizeof(CondVar));
+
+#if defined(_WIN32)
+    InitializeConditionVariable(&cond->cond);
+#else
+    pthread_cond_init(&cond->cond, NULL);
+#endif
+
+    return cond;
+}
+
+void UnloadCondVar(CondVar *cond)
+{
+    if (cond == NULL) return;
+
+#if !defined(_WIN32)
+    pthread_cond_destroy(&cond->cond);
+#endif
+    free(cond);
+}
+
+void WaitCondVar(CondVar *cond, Mutex *mutex)
+{
+#if defined(_WIN32)
+    SleepConditionVariableSRW(&cond->cond, &mutex->lock, INFINITE, 0);
+#else
+    pthread_cond_wait(&cond->cond, &mutex->lock);
+#endif
+}
+
+void SignalCondVar(CondVar *cond)
+{
+#if defined(_WIN32)
+    WakeConditionVariable(&cond->cond);
+#else
+    pthread_cond_signal(&cond->cond);
+#endif
+}
+
+void BroadcastCondVar(CondVar *cond)
+{
+#if defined(_WIN32)
+    WakeAllConditionVariable(&cond->cond);
+#else
+    pthread_cond_broadcast(&cond->cond);
+#endif
+}
+
+int AtomicLoad(volatile int *value)
+{
+#if defined(_MSC_VER)
+    return (int)InterlockedCompareExchange((volatile LONG *)value, 0, 0);
+#else
+    return __atomic_load_n(value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+void AtomicStore(volatile int *value, int newValue)
+{
+#if defined(_MSC_VER)
+    InterlockedExchange((volatile LONG *)value, newValue);
+#else
+    __atomic_store_n(value, newValue, __ATOMIC_SEQ_CST);
+#endif
+}
+
+int AtomicAdd(volatile int *value, int add)
+{
+#if defined(_MSC_VER)
+    return (int)InterlockedExchangeAdd((volatile LONG *)value, add) + add;
+#else
+    return __atomic_add_fetch(value, add, __ATOMIC_SEQ_CST);
+#endif
+}
+
+int AtomicCompareExchange(volatile int *value, int expected, int desired)
+{
+#if defined(_MSC_VER)
+    return (int)InterlockedCompareExchange((volatile LONG *)value, desired, expected);
+#else
+    __atomic_compare_exchange_n(value, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return expected;
+#endif
+}
@@ -0,0 +1,56 @@
+/**********************************************************************************************
+*
+*   Threads - Minimal portable threading primitives
+*
+*   Threads, mutexes, condition variables and atomic integers over Win32 or pthreads.
+*   Primitives are opaque and allocated by their Load*() function.
+*
+**********************************************************************************************/
+
+#ifndef THREADS_H
+#define THREADS_H
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct Thread Thread;
+typedef struct Mutex Mutex;
+typedef struct CondVar CondVar;
+
+typedef int (*ThreadFunc)(void *arg);
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Threads Functions Declaration
+//----------------------------------------------------------------------------------
+Thread *StartThread(ThreadFunc func, void *arg);    // Returns NULL on failure
+void JoinThread(Thread *thread);                    // Wait for thread to end and release it
+void YieldThread(void);
+void SleepThread(int milliseconds);                 // Granularity depends on the OS scheduler
+int GetCpuCount(void);                              // Logical processors available
+
+Mutex *LoadMutex(void);
+void UnloadMutex(Mutex *mutex);
+void LockMutex(Mutex *mutex);
+void UnlockMutex(Mutex *mutex);
+
+CondVar *LoadCondVar(void);
+void UnloadCondVar(CondVar *cond);
+void WaitCondVar(CondVar *cond, Mutex *mutex);      // Mutex must be locked
+void SignalCondVar(CondVar *cond);
+void BroadcastCondVar(CondVar *cond);
+
+// Sequentially consistent atomic operations
+int AtomicLoad(volatile int *value);
+void AtomicStore(volatile int *value, int newValue);
+int AtomicAdd(volatile int *value, int add);        // Returns the new value
+int AtomicCompareExchange(volatile int *value, int expected, int desired);  // Returns the previous value
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // THREADS_H
@@ -0,0 +1,41 @@
+/**********************************************************************************************
+*
+*   Timing - High resolution monotonic clock
+*
+*   NOTE: This module must not include raylib.h, windows.h declarations collide with it
+*
+**********************************************************************************************/
+
+#include "timing.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>        // Required for: QueryPerformanceCounter(), QueryPerformanceFrequency()
+#else
+    #include <time.h>           // Required for: clock_gettime()
+#endif
+
+//----------------------------------------------------------------------------------
+// Timing Functions Definition
+//----------------------------------------------------------------------------------
+unsigned long long GetTimestampNs(void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency = { 0 };
+    LARGE_INTEGER counter = { 0 };
+
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    // Split to avoid overflowing 64 bits on long uptimes
+    unsigned long long seconds = counter.QuadPart/frequency.QuadPart;
+    unsigned long long remainder = counter.QuadPart%frequency.QuadPart;
+
+    return seconds*1000000000ULL + remainder*1000000000ULL/frequency.QuadPart;
+#else
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (unsigned long long)now.tv_sec*1000000000ULL + (unsigned long long)now.tv_nsec;
+#endif
+}
@@ -0,0 +1,25 @@
+/**********************************************************************************************
+*
+*   Timing - High resolution monotonic clock
+*
+*   Works without a window, unlike raylib GetTime(), so it can be used by headless tools.
+*
+**********************************************************************************************/
+
+#ifndef TIMING_H
+#define TIMING_H
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Timing Functions Declaration
+//----------------------------------------------------------------------------------
+unsigned long long GetTimestampNs(void);    // Monotonic timestamp in nanoseconds
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TIMING_H
@@ -0,0 +1,41 @@
+/**********************************************************************************************
+*
+*   Memory Usage - Process resident memory
+*
+*   NOTE: This module must not include raylib.h, windows.h declarations collide with it
+*
+**********************************************************************************************/
+
+#include "memory_usage.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #include <psapi.h>          // Required for: GetProcessMemoryInfo()
+#else
+    #include <sys/resource.h>   // Required for: getrusage()
+#endif
+
+//----------------------------------------------------------------------------------
+// Memory Usage Functions Definition
+//----------------------------------------------------------------------------------
+size_t GetPeakResidentBytes(void)
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters = { 0 };
+
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+
+    return (size_t)counters.PeakWorkingSetSize;
+#else
+    struct rusage usage = { 0 };
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+
+#if defined(__APPLE__)
+    return (size_t)usage.ru_maxrss;         // Bytes on macOS
+#else
+    return (size_t)usage.ru_maxrss*1024;    // Kilobytes on Linux and BSDs
+#endif
+#endif
+}
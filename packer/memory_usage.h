@@ -0,0 +1,17 @@
+/**********************************************************************************************
+*
+*   Memory Usage - Process resident memory
+*
+**********************************************************************************************/
+
+#ifndef MEMORY_USAGE_H
+#define MEMORY_USAGE_H
+
+#include <stddef.h>         // Required for: size_t
+
+//----------------------------------------------------------------------------------
+// Memory Usage Functions Declaration
+//----------------------------------------------------------------------------------
+size_t GetPeakResidentBytes(void);      // Highest resident set size of the process so far, 0 if unknown
+
+#endif // MEMORY_USAGE_H
@@ -0,0 +1,365 @@
+/**********************************************************************************************
+*
+*   Shooter packer - Packs resources/ into a memory mappable bundle
+*
+*   Usage: shooter_packer <resources dir> <bundle>
+*     Decodes images and waves, stores other files raw, see bundle.h for the layout.
+*
+*   Usage: shooter_packer bench <resources dir> <bundle>
+*     Startup benchmark: loads every image and wave of the directory as separate files
+*     and from the bundle, each in a fresh process so peak memory is measured per method.
+*     Cached pages of the files are dropped before every run where the OS allows it
+*     (posix_fadvise()), so runs are cold starts. Elsewhere runs after the first one find
+*     files in the OS cache and timings are warm starts, the output tells which.
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+#include "bundle.h"
+#include "timing.h"
+#include "memory_usage.h"
+
+#include <stdio.h>          // Required for: FILE, fopen(), fwrite(), printf(), snprintf()
+#include <stdlib.h>         // Required for: calloc(), free(), qsort(), system()
+#include <string.h>         // Required for: strcmp(), strncpy(), strlen()
+
+#if !defined(_WIN32)
+    #include <fcntl.h>          // Required for: open(), posix_fadvise()
+    #include <unistd.h>         // Required for: close(), fdatasync()
+#endif
+
+#define IMAGE_EXTENSIONS    ".png;.bmp;.tga;.jpg;.gif;.qoi;.psd;.hdr;.dds;.pkm;.ktx;.pvr;.astc"
+#define BENCH_RUNS          5
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static int PackBundle(const char *resourcesDir, const char *bundleFile);
+static int RunStartupBenchmark(const char *program, const char *resourcesDir, const char *bundleFile);
+static int LoadFromFiles(const char *resourcesDir);
+static int LoadFromBundle(const char *bundleFile);
+static FilePathList LoadAssetFiles(const char *resourcesDir);
+static bool DropFileCache(const char *resourcesDir, const char *bundleFile);   // False if some file is still cached
+static bool DropCachedPages(const char *fileName);
+static int GetImageDataSize(Image image);
+static unsigned int TouchData(const void *data, int size);
+static bool WritePadding(FILE *file, long offset);
+static int CompareStrings(const void *a, const void *b);
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    SetTraceLogLevel(LOG_WARNING);
+
+    if ((argc == 3) && (strcmp(argv[1], "load-files") == 0)) return LoadFromFiles(argv[2]);
+    if ((argc == 3) && (strcmp(argv[1], "load-bundle") == 0)) return LoadFromBundle(argv[2]);
+    if ((argc == 4) && (strcmp(argv[1], "bench") == 0)) return RunStartupBenchmark(argv[0], argv[2], argv[3]);
+    if (argc == 3) return PackBundle(argv[1], argv[2]);
+
+    printf("Usage: shooter_packer <resources dir> <bundle>\n");
+    printf("       shooter_packer bench <resources dir> <bundle>\n");
+
+    return 1;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static int PackBundle(const char *resourcesDir, const char *bundleFile)
+{
+    FilePathList files = LoadAssetFiles(resourcesDir);
+    BundleEntry *entries = (BundleEntry *)calloc(files.count + 1, sizeof(BundleEntry));
+    BundleHeader header = { { 'S', 'H', 'P', 'K' }, BUNDLE_VERSION, 0, 0 };
+    FILE *file = fopen(bundleFile, "wb");
+    bool success = (file != NULL);
+
+    // Index size is only known once skipped files are known, reserve room for all of them
+    long dataStart = (long)(sizeof(BundleHeader) + files.count*sizeof(BundleEntry));
+    dataStart = (dataStart + BUNDLE_ALIGNMENT - 1)/BUNDLE_ALIGNMENT*BUNDLE_ALIGNMENT;
+    long offset = dataStart;
+
+    if (success) success = WritePadding(file, dataStart);
+
+    for (unsigned int i = 0; success && (i < files.count); i++)
+    {
+        const char *name = GetFileName(files.paths[i]);
+        BundleEntry *entry = &entries[header.entryCount];
+
+        if (!IsPathFile(files.paths[i])) continue;
+
+        if ((strcmp(name, GetFileName(bundleFile)) == 0) || (strlen(name) >= BUNDLE_NAME_SIZE))
+        {
+            printf("  skipped  %s\n", name);
+            continue;
+        }
+
+        strncpy(entry->name, name, BUNDLE_NAME_SIZE - 1);
+        entry->offset = (unsigned int)offset;
+
+        if (IsFileExtension(name, IMAGE_EXTENSIONS))
+        {
+            Image image = LoadImage(files.paths[i]);
+
+            entry->type = BUNDLE_ENTRY_IMAGE;
+            entry->size = (unsigned int)GetImageDataSize(image);
+            entry->params[0] = image.width;
+            entry->params[1] = image.height;
+            entry->params[2] = image.mipmaps;
+            entry->params[3] = image.format;
+            success = (image.data != NULL) && (fwrite(image.data, 1, entry->size, file) == entry->size);
+
+            UnloadImage(image);
+        }
+        else if (IsFileExtension(name, ".wav"))
+        {
+            Wave wave = LoadWave(files.paths[i]);
+
+            entry->type = BUNDLE_ENTRY_WAVE;
+            entry->size = wave.frameCount*wave.channels*(wave.sampleSize/8);
+            entry->params[0] = (int)wave.frameCount;
+            entry->params[1] = (int)wave.sampleRate;
+            entry->params[2] = (int)wave.sampleSize;
+            entry->params[3] = (int)wave.channels;
+            success = (wave.data != NULL) && (fwrite(wave.data, 1, entry->size, file) == entry->size);
+
+            UnloadWave(wave);
+        }
+        else
+        {
+            int dataSize = 0;
+            unsigned char *data = LoadFileData(files.paths[i], &dataSize);
+
+            entry->type = BUNDLE_ENTRY_RAW;
+            entry->size = (unsigned int)dataSize;
+            success = (data != NULL) && (fwrite(data, 1, entry->size, file) == entry->size);
+
+            UnloadFileData(data);
+        }
+
+        if (!success)
+        {
+            printf("  failed   %s\n", name);
+            break;
+        }
+
+        printf("  %-8s %-24s %8u bytes\n", (entry->type == BUNDLE_ENTRY_IMAGE)? "image" : (entry->type == BUNDLE_ENTRY_WAVE)? "wave" : "raw", name, entry->size);
+
+        offset += entry->size;
+        offset = (offset + BUNDLE_ALIGNMENT - 1)/BUNDLE_ALIGNMENT*BUNDLE_ALIGNMENT;
+        success = WritePadding(file, offset);
+        header.entryCount++;
+    }
+
+    // Index goes in front of data, written last
+    header.dataSize = (unsigned int)(offset - dataStart);
+
+    if (success) success = (fseek(file, 0, SEEK_SET) == 0) &&
+                           (fwrite(&header, sizeof(BundleHeader), 1, file) == 1) &&
+                           (fwrite(entries, sizeof(BundleEntry), header.entryCount, file) == header.entryCount);
+
+    if (file != NULL) fclose(file);
+    free(entries);
+    UnloadDirectoryFiles(files);
+
+    if (!success)
+    {
+        printf("Failed to pack '%s' into '%s'\n", resourcesDir, bundleFile);
+        remove(bundleFile);
+        return 1;
+    }
+
+    printf("Packed %u assets into '%s' (%ld bytes)\n", header.entryCount, bundleFile, offset);
+
+    return 0;
+}
+
+// Run every load method in its own process, alternating, so no run inherits another's memory
+static int RunStartupBenchmark(const char *program, const char *resourcesDir, const char *bundleFile)
+{
+    char command[1024] = { 0 };
+    bool cold = DropFileCache(resourcesDir, bundleFile);
+
+    if (cold) printf("Cold starts: file pages dropped from the OS cache before every run\n");
+    else printf("Warm starts only: file pages could not be dropped, runs after the first one read cached files\n");
+
+    printf("%-8s %12s %14s %14s  %s\n", "method", "load ms", "peak MB", "before MB", "data sum");
+    fflush(stdout);     // Children write to the same output
+
+    for (int r = 0; r < BENCH_RUNS; r++)
+    {
+        if (cold) DropFileCache(resourcesDir, bundleFile);
+        snprintf(command, sizeof(command), "\"%s\" load-files \"%s\"", program, resourcesDir);
+        if (system(command) != 0) return 1;
+
+        if (cold) DropFileCache(resourcesDir, bundleFile);
+        snprintf(command, sizeof(command), "\"%s\" load-bundle \"%s\"", program, bundleFile);
+        if (system(command) != 0) return 1;
+    }
+
+    return 0;
+}
+
+// Load assets the way the game did before bundles: open, read and decode every file
+static int LoadFromFiles(const char *resourcesDir)
+{
+    FilePathList files = LoadAssetFiles(resourcesDir);
+    size_t before = GetPeakResidentBytes();
+    unsigned int checksum = 0;
+
+    unsigned long long start = GetTimestampNs();
+
+    for (unsigned int i = 0; i < files.count; i++)
+    {
+        if (IsFileExtension(files.paths[i], IMAGE_EXTENSIONS))
+        {
+            Image image = LoadImage(files.paths[i]);
+            checksum += TouchData(image.data, GetImageDataSize(image));
+            UnloadImage(image);
+        }
+        else if (IsFileExtension(files.paths[i], ".wav"))
+        {
+            Wave wave = LoadWave(files.paths[i]);
+            checksum += TouchData(wave.data, wave.frameCount*wave.channels*(wave.sampleSize/8));
+            UnloadWave(wave);
+        }
+    }
+
+    double ms = (GetTimestampNs() - start)/1e6;
+
+    printf("%-8s %12.3f %14.2f %14.2f  %08x\n", "files", ms, GetPeakResidentBytes()/(1024.0*1024.0), before/(1024.0*1024.0), checksum);
+    UnloadDirectoryFiles(files);
+
+    return 0;
+}
+
+// Same assets from the bundle, data is read straight from the mapping
+static int LoadFromBundle(const char *bundleFile)
+{
+    size_t before = GetPeakResidentBytes();
+    unsigned int checksum = 0;
+
+    unsigned long long start = GetTimestampNs();
+
+    Bundle bundle = LoadBundle(bundleFile);
+    if (!IsBundleReady(bundle)) return 1;
+
+    for (int i = 0; i < bundle.entryCount; i++)
+    {
+        const BundleEntry *entry = &bundle.entries[i];
+
+        if (entry->type == BUNDLE_ENTRY_IMAGE)
+        {
+            Image image = GetBundleImage(bundle, entry->name);
+            checksum += TouchData(image.data, (int)entry->size);
+        }
+        else if (entry->type == BUNDLE_ENTRY_WAVE)
+        {
+            Wave wave = GetBundleWave(bundle, entry->name);
+            checksum += TouchData(wave.data, (int)entry->size);
+        }
+    }
+
+    double ms = (GetTimestampNs() - start)/1e6;
+
+    printf("%-8s %12.3f %14.2f %14.2f  %08x\n", "bundle", ms, GetPeakResidentBytes()/(1024.0*1024.0), before/(1024.0*1024.0), checksum);
+    UnloadBundle(bundle);
+
+    return 0;
+}
+
+// Entries of the directory, sorted so bundles are reproducible
+// NOTE: Subdirectories are listed too, callers skip them
+static FilePathList LoadAssetFiles(const char *resourcesDir)
+{
+    FilePathList files = LoadDirectoryFiles(resourcesDir);
+    qsort(files.paths, files.count, sizeof(char *), CompareStrings);
+
+    return files;
+}
+
+// Forget cached pages of the bundle and of every asset the loose files method loads
+static bool DropFileCache(const char *resourcesDir, const char *bundleFile)
+{
+    FilePathList files = LoadAssetFiles(resourcesDir);
+    bool dropped = DropCachedPages(bundleFile);
+
+    for (unsigned int i = 0; i < files.count; i++)
+    {
+        bool asset = IsFileExtension(files.paths[i], IMAGE_EXTENSIONS) || IsFileExtension(files.paths[i], ".wav");
+        if (asset && !DropCachedPages(files.paths[i])) dropped = false;
+    }
+
+    UnloadDirectoryFiles(files);
+
+    return dropped;
+}
+
+// Dirty pages are not dropped, a freshly packed bundle is written back first
+// NOTE: Pages some process maps stay cached, bench children have exited when it is called
+static bool DropCachedPages(const char *fileName)
+{
+#if defined(POSIX_FADV_DONTNEED)
+    int descriptor = open(fileName, O_RDONLY);
+    if (descriptor < 0) return false;
+
+    fdatasync(descriptor);
+    bool dropped = (posix_fadvise(descriptor, 0, 0, POSIX_FADV_DONTNEED) == 0);
+    close(descriptor);
+
+    return dropped;
+#else
+    (void)fileName;
+    return false;
+#endif
+}
+
+// Bytes of pixel data for all mipmap levels
+static int GetImageDataSize(Image image)
+{
+    int width = image.width;
+    int height = image.height;
+    int size = 0;
+
+    for (int level = 0; level < image.mipmaps; level++)
+    {
+        size += GetPixelDataSize(width, height, image.format);
+        width = (width > 1)? width/2 : 1;
+        height = (height > 1)? height/2 : 1;
+    }
+
+    return size;
+}
+
+// Read every byte, as a texture upload or audio conversion would
+static unsigned int TouchData(const void *data, int size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    unsigned int sum = 0;
+
+    for (int i = 0; i < size; i++) sum += bytes[i];
+
+    return sum;
+}
+
+// Zero fill file up to offset
+static bool WritePadding(FILE *file, long offset)
+{
+    static const unsigned char zeros[BUNDLE_ALIGNMENT] = { 0 };
+    long position = ftell(file);
+
+    while (position < offset)
+    {
+        long count = ((offset - position) < BUNDLE_ALIGNMENT)? (offset - position) : BUNDLE_ALIGNMENT;
+        if (fwrite(zeros, 1, count, file) != (size_t)count) return false;
+        position += count;
+    }
+
+    return true;
+}
+
+static int CompareStrings(const void *a, const void *b)
+{
+    return strcmp(*(const char **)a, *(const char **)b);
+}
@@ -0,0 +1,37 @@
+-- Asset packer, packs resources/ into the bundle the game maps at startup
+
+project (workspaceName .. "_packer")
+    kind "ConsoleApp"
+    location "../_build"
+    targetdir "../_bin/%{cfg.buildcfg}"
+
+    filter "action:vs*"
+        debugdir "$(SolutionDir)"
+
+    filter{}
+
+    vpaths
+    {
+        ["Header Files/*"] = { "**.h", "../game/src/**.h" },
+        ["Source Files/*"] = { "**.c", "../game/src/**.c" },
+    }
+    files {"**.c", "**.h"}
+
+    -- Bundle format and loader are shared with the game
+    files
+    {
+        "../game/src/bundle.c",
+        "../game/src/mapped_file.c",
+        "../game/src/timing.c",
+    }
+
+    includedirs { "./" }
+    includedirs { "../game/src" }
+
+    -- Images and waves are decoded with raylib, no window or audio device is opened
+    link_raylib()
+
+    filter "system:windows"
+        links {"psapi"}
+
+    filter{}
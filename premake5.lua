@@ -13,6 +13,19 @@ newoption
     default = "opengl33"
 }
 
+newoption
+{
+    trigger = "simd",
+    value = "INSTRUCTION_SET",
+    description = "SIMD instruction set for the bullet kernels",
+    allowed = {
+        { "none", "Scalar code only"},
+        { "sse2", "SSE2, 4 bullets per instruction (x86/x64)"},
+        { "avx", "AVX, 8 bullets per instruction (x86/x64)"}
+    },
+    default = "sse2"
+}
+
 function string.starts(String,Start)
     return string.sub(String,1,string.len(Start))==Start
 end
@@ -69,6 +82,15 @@ workspace (workspaceName)
 
     filter { "platforms:x64" }
         architecture "x86_64"
+
+    filter { "options:simd=none" }
+        defines { "BULLETS_NO_SIMD", "PARTICLES_NO_SIMD" }
+
+    filter { "options:simd=sse2", "platforms:x64 or x86" }
+        vectorextensions "SSE2"
+
+    filter { "options:simd=avx", "platforms:x64 or x86" }
+        vectorextensions "AVX"
 		
 	filter { "platforms:Arm64" }
         architecture "ARM64"